@@ -0,0 +1,720 @@
+// standard allocation workloads of segment_manager_t against system malloc
+// usage: EightmoryBenchmarks [output.json] [scale]
+// on Linux hardware counters are reported per operation, if perf_event_open is permitted
+
+#include <Eightmory/Core.hpp>
+#include <Eightmory/Cache.hpp>
+#include <Eightmory/Counters.hpp>
+#include <Eightmory/Pool.hpp>
+
+#include <cstdio> // printf, fprintf, fopen
+#include <cstdlib> // atoi, malloc, realloc, free
+#include <cstring> // memcpy
+#include <algorithm> // min, max, fill
+#include <atomic> // atomic
+#include <bit> // bit_width
+#include <chrono> // steady_clock
+#include <cstddef> // max_align_t
+#include <deque> // deque
+#include <functional> // greater
+#include <mutex> // mutex, lock_guard
+#include <queue> // priority_queue
+#include <random> // mt19937_64
+#include <thread> // thread
+#include <type_traits> // is_same_v
+#include <utility> // pair
+#include <vector> // vector
+
+using eightmory::segment_t;
+using eightmory::segment_manager_t;
+
+using eightmory::perf_counter_t;
+using eightmory::perf_sample_t;
+using eightmory::perf_counters_t;
+
+using eightmory::fixed_pool_t;
+using eightmory::fixed_pool_cache_t;
+
+using eightmory::add_isolated_segment;
+using eightmory::remove_isolated_segment;
+
+static constexpr auto heap_bytes = std::size_t(64) << 20;
+static constexpr auto repetitions = std::size_t(3);
+static constexpr auto seed = std::uint64_t(0x8E16);
+
+enum class op_kind_t : std::uint8_t
+{
+    add,
+    reallocate,
+    remove,
+};
+
+// scripted operation on allocation id, generated before timing
+struct op_t
+{
+    op_kind_t kind = op_kind_t::add;
+    std::uint32_t id = 0;
+    std::uint32_t size = 0;
+};
+
+struct script_t
+{
+    std::vector<op_t> ops;
+    std::size_t id_count = 0;
+
+    std::uint32_t add(std::uint32_t size)
+    {
+        auto const id = static_cast<std::uint32_t>(id_count++);
+        ops.push_back({op_kind_t::add, id, size});
+        return id;
+    }
+
+    void reallocate(std::uint32_t id, std::uint32_t size) { ops.push_back({op_kind_t::reallocate, id, size}); }
+    void remove(std::uint32_t id) { ops.push_back({op_kind_t::remove, id, 0}); }
+};
+
+struct result_t
+{
+    char const* workload = "";
+    char const* allocator = "";
+    std::size_t operations = 0;
+    std::size_t failures = 0;
+    std::size_t threads = 1;
+    double seconds = 0.0;
+
+    // counted in separate untimed run, since reading counters has own cost
+    bool has_counters = false;
+    perf_sample_t counters;
+};
+
+struct manager_target_t
+{
+    static constexpr char const* name = "segment_manager_t";
+
+    manager_target_t() : heap(heap_bytes / sizeof(std::max_align_t)), manager(heap.data(), heap_bytes) {}
+
+    void reset() noexcept { manager = segment_manager_t(heap.data(), heap_bytes); }
+
+    void* add(std::size_t size) noexcept { return manager.add_segment(size); }
+
+    // realloc semantic: grow in place or move
+    void* reallocate(void* memory, std::size_t size) noexcept
+    {
+        // extend_segment takes extra size, not total one
+        auto const current = segment_t::segment(memory)->size;
+        if (current >= size || manager.extend_segment(memory, size - current))
+        {
+            return memory;
+        }
+
+        auto const moved = manager.add_segment(size);
+        if (moved != nullptr)
+        {
+            std::memcpy(moved, memory, current);
+            manager.remove_segment(memory);
+        }
+        return moved;
+    }
+
+    void remove(void* memory) noexcept { manager.remove_segment(memory); }
+
+    std::vector<std::max_align_t> heap;
+    segment_manager_t manager;
+};
+
+struct malloc_target_t
+{
+    static constexpr char const* name = "malloc";
+
+    void reset() noexcept {}
+
+    void* add(std::size_t size) noexcept { return std::malloc(size == 0 ? 1 : size); }
+    void* reallocate(void* memory, std::size_t size) noexcept { return std::realloc(memory, size); }
+    void remove(void* memory) noexcept { std::free(memory); }
+};
+
+template <typename TargetType>
+static std::size_t run_script(TargetType& target, script_t const& script, std::vector<void*>& memory) noexcept
+{
+    auto failures = std::size_t(0);
+    for (auto const& op : script.ops)
+    {
+        auto& slot = memory[op.id];
+        switch (op.kind)
+        {
+        case op_kind_t::add:
+            slot = target.add(op.size);
+            failures += slot == nullptr;
+            break;
+        case op_kind_t::reallocate:
+            if (slot != nullptr)
+            {
+                auto const updated = target.reallocate(slot, op.size);
+                failures += updated == nullptr;
+                if (updated != nullptr) slot = updated;
+            }
+            break;
+        case op_kind_t::remove:
+            if (slot != nullptr) target.remove(slot);
+            slot = nullptr;
+            break;
+        }
+    }
+    return failures;
+}
+
+template <typename TargetType>
+static void release_script(TargetType& target, std::vector<void*>& memory) noexcept
+{
+    // scripts may keep allocations alive until the end
+    for (auto& slot : memory)
+    {
+        if (slot != nullptr) target.remove(slot);
+        slot = nullptr;
+    }
+}
+
+template <typename TargetType>
+static result_t measure_script(char const* workload, script_t const& script, perf_counters_t& counters)
+{
+    TargetType target;
+    std::vector<void*> memory(script.id_count);
+
+    result_t result;
+    result.workload = workload;
+    result.allocator = TargetType::name;
+    result.operations = script.ops.size();
+
+    for (std::size_t repetition = 0; repetition < repetitions; ++repetition)
+    {
+        target.reset();
+        std::fill(memory.begin(), memory.end(), nullptr);
+
+        auto const start = std::chrono::steady_clock::now();
+        result.failures = run_script(target, script, memory);
+        auto const seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        if (repetition == 0 || seconds < result.seconds) result.seconds = seconds;
+
+        release_script(target, memory);
+    }
+
+    if (counters.is_open())
+    {
+        target.reset();
+
+        counters.start();
+        run_script(target, script, memory);
+        counters.stop();
+        result.has_counters = counters.read(result.counters);
+
+        release_script(target, memory);
+    }
+    return result;
+}
+
+// sizes are log-uniform in [1, max_size], as in most real programs small requests dominate
+static std::uint32_t random_size(std::mt19937_64& engine, std::uint32_t max_size)
+{
+    auto const bits = std::uniform_int_distribution<std::uint32_t>(0, std::bit_width(max_size) - 1)(engine);
+    auto const size = std::uniform_int_distribution<std::uint32_t>(1u << bits, (2u << bits) - 1)(engine);
+    return std::min(size, max_size);
+}
+
+static script_t make_random_sizes(std::size_t scale)
+{
+    std::mt19937_64 engine(seed);
+    script_t script;
+    std::vector<std::uint32_t> live;
+
+    for (std::size_t step = 0; step < 100000 * scale; ++step)
+    {
+        if (live.size() < 4096 && (live.empty() || engine() % 2 == 0))
+        {
+            live.push_back(script.add(random_size(engine, 4096)));
+        }
+        else
+        {
+            auto const index = engine() % live.size();
+            script.remove(live[index]);
+            live[index] = live.back();
+            live.pop_back();
+        }
+    }
+    return script;
+}
+
+static script_t make_lifo(std::size_t scale)
+{
+    std::mt19937_64 engine(seed);
+    script_t script;
+    std::vector<std::uint32_t> stack;
+
+    for (std::size_t round = 0; round < 100 * scale; ++round)
+    {
+        for (std::size_t count = 0; count < 500; ++count) stack.push_back(script.add(random_size(engine, 256)));
+        while (!stack.empty())
+        {
+            script.remove(stack.back());
+            stack.pop_back();
+        }
+    }
+    return script;
+}
+
+static script_t make_fifo(std::size_t scale)
+{
+    std::mt19937_64 engine(seed);
+    script_t script;
+    std::deque<std::uint32_t> queue;
+
+    for (std::size_t step = 0; step < 50000 * scale; ++step)
+    {
+        queue.push_back(script.add(random_size(engine, 256)));
+        if (queue.size() > 500)
+        {
+            script.remove(queue.front());
+            queue.pop_front();
+        }
+    }
+    return script;
+}
+
+static script_t make_realloc_heavy(std::size_t scale)
+{
+    std::mt19937_64 engine(seed);
+    script_t script;
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> buffers; // id, size
+
+    for (std::size_t step = 0; step < 50000 * scale; ++step)
+    {
+        if (buffers.size() < 256)
+        {
+            auto const size = random_size(engine, 64);
+            buffers.emplace_back(script.add(size), size);
+            continue;
+        }
+
+        auto const index = engine() % buffers.size();
+        auto& [id, size] = buffers[index];
+        if (size > 16384 || engine() % 8 == 0)
+        {
+            script.remove(id);
+            buffers[index] = buffers.back();
+            buffers.pop_back();
+        }
+        else
+        {
+            // vector-like growth
+            size += size / 2 + 1;
+            script.reallocate(id, size);
+        }
+    }
+    return script;
+}
+
+// interleave small and large blocks, free small ones and ask for blocks that do not fit into holes
+static script_t make_fragmentation(std::size_t scale)
+{
+    std::mt19937_64 engine(seed);
+    script_t script;
+    std::vector<std::uint32_t> small;
+    std::vector<std::uint32_t> large;
+
+    for (std::size_t round = 0; round < 20 * scale; ++round)
+    {
+        for (std::size_t count = 0; count < 1000; ++count)
+        {
+            small.push_back(script.add(16 + engine() % 48));
+            large.push_back(script.add(256 + engine() % 256));
+        }
+        for (auto id : small) script.remove(id);
+        small.clear();
+
+        for (std::size_t count = 0; count < 500; ++count) large.push_back(script.add(96 + engine() % 64));
+        for (auto id : large) script.remove(id);
+        large.clear();
+    }
+    return script;
+}
+
+// most allocations die young, few of them live for a long time
+static script_t make_long_tail(std::size_t scale)
+{
+    std::mt19937_64 engine(seed);
+    std::exponential_distribution<double> lifetime(0.05);
+    script_t script;
+
+    using death_t = std::pair<std::size_t, std::uint32_t>; // step, id
+    std::priority_queue<death_t, std::vector<death_t>, std::greater<death_t>> deaths;
+
+    auto const steps = 100000 * scale;
+    for (std::size_t step = 0; step < steps; ++step)
+    {
+        while (!deaths.empty() && deaths.top().first <= step)
+        {
+            script.remove(deaths.top().second);
+            deaths.pop();
+        }
+
+        auto const id = script.add(random_size(engine, 1024));
+        auto life = static_cast<std::size_t>(lifetime(engine));
+        if (engine() % 100 == 0) life *= 1000;
+        deaths.emplace(step + 1 + life, id);
+    }
+    return script;
+}
+
+// producer thread allocates messages, consumer thread releases them
+// segment_manager_t is not thread-safe, so it is guarded by mutex like in user code
+// counters are per thread, so they are not reported for this workload
+template <typename TargetType>
+static result_t measure_producer_consumer(std::size_t scale)
+{
+    static constexpr auto batch = std::size_t(64);
+    auto const messages = 100000 * scale;
+
+    TargetType target;
+    std::mutex target_mutex;
+
+    result_t result;
+    result.workload = "producer_consumer";
+    result.allocator = TargetType::name;
+    result.threads = 2;
+    result.operations = 2 * messages;
+
+    for (std::size_t repetition = 0; repetition < repetitions; ++repetition)
+    {
+        target.reset();
+
+        std::mutex queue_mutex;
+        std::deque<void*> queue;
+        auto is_done = false;
+        auto failures = std::size_t(0);
+
+        auto const start = std::chrono::steady_clock::now();
+        std::thread consumer([&]
+        {
+            std::vector<void*> received;
+            for (;;)
+            {
+                auto is_last = false;
+                {
+                    std::lock_guard<std::mutex> lock(queue_mutex);
+                    received.assign(queue.begin(), queue.end());
+                    queue.clear();
+                    is_last = is_done;
+                }
+                for (auto memory : received)
+                {
+                    std::lock_guard<std::mutex> lock(target_mutex);
+                    target.remove(memory);
+                }
+                if (is_last && received.empty()) break;
+                if (received.empty()) std::this_thread::yield();
+            }
+        });
+
+        std::mt19937_64 engine(seed);
+        std::vector<void*> produced;
+        for (std::size_t message = 0; message < messages; ++message)
+        {
+            auto const size = random_size(engine, 512);
+            void* memory = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(target_mutex);
+                memory = target.add(size);
+            }
+            if (memory == nullptr)
+            {
+                ++failures;
+            }
+            else
+            {
+                produced.push_back(memory);
+            }
+
+            if (produced.size() == batch || message + 1 == messages)
+            {
+                std::lock_guard<std::mutex> lock(queue_mutex);
+                queue.insert(queue.end(), produced.begin(), produced.end());
+                produced.clear();
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            is_done = true;
+        }
+        consumer.join();
+
+        auto const seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (repetition == 0 || seconds < result.seconds) result.seconds = seconds;
+        result.failures = failures;
+    }
+    return result;
+}
+
+// fixed size pool guarded by mutex, baseline for lock-free pool
+class mutex_pool_t
+{
+public:
+    mutex_pool_t(void* memory, std::size_t bytes, std::size_t block_size) noexcept
+    {
+        auto const count = bytes / block_size;
+        for (std::size_t index = count; index-- > 0;)
+        {
+            auto block = static_cast<char*>(memory) + index * block_size;
+            *reinterpret_cast<void**>(block) = xxfirst;
+            xxfirst = block;
+        }
+    }
+
+    void* allocate() noexcept
+    {
+        std::lock_guard<std::mutex> lock(xxmutex);
+        auto block = xxfirst;
+        if (block != nullptr) xxfirst = *reinterpret_cast<void**>(block);
+        return block;
+    }
+
+    void deallocate(void* block) noexcept
+    {
+        std::lock_guard<std::mutex> lock(xxmutex);
+        *reinterpret_cast<void**>(block) = xxfirst;
+        xxfirst = block;
+    }
+
+private:
+    std::mutex xxmutex;
+    void* xxfirst = nullptr;
+};
+
+struct pool_cache_target_t
+{
+    static constexpr char const* name = "fixed_pool_cache_t";
+
+    pool_cache_target_t(void* memory, std::size_t bytes, std::size_t block_size) noexcept : pool(memory, bytes, block_size) {}
+
+    fixed_pool_t pool;
+};
+
+struct mutex_pool_target_t
+{
+    static constexpr char const* name = "mutex_pool";
+
+    mutex_pool_target_t(void* memory, std::size_t bytes, std::size_t block_size) noexcept : pool(memory, bytes, block_size) {}
+
+    mutex_pool_t pool;
+};
+
+// job system pattern: every thread allocates burst of small task records and frees them
+template <typename TargetType>
+static result_t measure_fixed_pool(std::size_t thread_count, std::size_t scale)
+{
+    static constexpr auto block_size = std::size_t(64);
+    static constexpr auto burst = std::size_t(64);
+    auto const rounds = 2000 * scale;
+
+    // pool is carved from single segment of manager
+    manager_target_t heap;
+    auto const bytes = fixed_pool_t::bytes_for(block_size, thread_count * burst * 4);
+    auto const memory = heap.add(bytes);
+
+    result_t result;
+    result.workload = "fixed_pool";
+    result.allocator = TargetType::name;
+    result.threads = thread_count;
+    result.operations = 2 * thread_count * rounds * burst;
+
+    // pool does not fit heap, so every operation fails
+    if (memory == nullptr)
+    {
+        result.failures = result.operations;
+        return result;
+    }
+
+    for (std::size_t repetition = 0; repetition < repetitions; ++repetition)
+    {
+        TargetType target(memory, bytes, block_size);
+        std::atomic<std::size_t> failures{0};
+
+        auto const start = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (std::size_t thread = 0; thread < thread_count; ++thread)
+        {
+            threads.emplace_back([&target, &failures, rounds]
+            {
+                void* blocks[burst];
+                if constexpr (std::is_same_v<TargetType, pool_cache_target_t>)
+                {
+                    fixed_pool_cache_t cache(target.pool);
+                    for (std::size_t round = 0; round < rounds; ++round)
+                    {
+                        for (auto& block : blocks) failures += (block = cache.allocate()) == nullptr;
+                        for (auto block : blocks) if (block != nullptr) cache.deallocate(block);
+                    }
+                }
+                else
+                {
+                    for (std::size_t round = 0; round < rounds; ++round)
+                    {
+                        for (auto& block : blocks) failures += (block = target.pool.allocate()) == nullptr;
+                        for (auto block : blocks) if (block != nullptr) target.pool.deallocate(block);
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+
+        auto const seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (repetition == 0 || seconds < result.seconds) result.seconds = seconds;
+        result.failures = failures;
+    }
+    return result;
+}
+
+// simulation step pattern: every thread updates own hot counter
+// counters of plain segments share cache lines, isolated ones do not
+template <bool IsIsolated>
+static result_t measure_counters(std::size_t thread_count, std::size_t scale)
+{
+    auto const rounds = 1000000 * scale;
+
+    manager_target_t heap;
+
+    result_t result;
+    result.workload = "counters";
+    result.allocator = IsIsolated ? "add_isolated_segment" : "add_segment";
+    result.threads = thread_count;
+    result.operations = thread_count * rounds;
+
+    for (std::size_t repetition = 0; repetition < repetitions; ++repetition)
+    {
+        heap.reset();
+
+        std::vector<std::atomic<std::size_t>*> counters;
+        for (std::size_t thread = 0; thread < thread_count; ++thread)
+        {
+            auto memory = IsIsolated ? add_isolated_segment(heap.manager, sizeof(std::size_t)) : heap.add(sizeof(std::size_t));
+            counters.push_back(new (memory) std::atomic<std::size_t>(0));
+        }
+
+        auto const start = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (auto counter : counters)
+        {
+            threads.emplace_back([counter, rounds]
+            {
+                for (std::size_t round = 0; round < rounds; ++round) counter->fetch_add(1, std::memory_order_relaxed);
+            });
+        }
+        for (auto& thread : threads) thread.join();
+
+        auto const seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (repetition == 0 || seconds < result.seconds) result.seconds = seconds;
+
+        for (auto counter : counters)
+        {
+            result.failures += counter->load() != rounds;
+            IsIsolated ? remove_isolated_segment(heap.manager, counter) : heap.manager.remove_segment(counter);
+        }
+    }
+    return result;
+}
+
+static void write_json(std::FILE* file, std::vector<result_t> const& results, std::size_t scale, bool has_counters)
+{
+    std::fprintf(file, "{\n");
+    std::fprintf(file, "  \"benchmark\": \"Eightmory\",\n");
+    std::fprintf(file, "  \"heap_bytes\": %zu,\n", heap_bytes);
+    std::fprintf(file, "  \"scale\": %zu,\n", scale);
+    std::fprintf(file, "  \"repetitions\": %zu,\n", repetitions);
+    std::fprintf(file, "  \"has_counters\": %s,\n", has_counters ? "true" : "false");
+    std::fprintf(file, "  \"results\": [\n");
+    for (std::size_t index = 0; index < results.size(); ++index)
+    {
+        auto const& result = results[index];
+        auto const ns_per_op = result.operations == 0 ? 0.0 : result.seconds * 1e9 / static_cast<double>(result.operations);
+        std::fprintf
+        (
+            file,
+            "    {\"workload\": \"%s\", \"allocator\": \"%s\", \"threads\": %zu, \"operations\": %zu, \"failures\": %zu, \"seconds\": %.9f, \"ns_per_op\": %.3f",
+            result.workload, result.allocator, result.threads, result.operations, result.failures, result.seconds, ns_per_op
+        );
+
+        if (result.has_counters)
+        {
+            auto separator = "";
+            std::fprintf(file, ", \"per_op\": {");
+            for (std::size_t counter = 0; counter < perf_sample_t::counter_count; ++counter)
+            {
+                auto const kind = static_cast<perf_counter_t>(counter);
+                if (!result.counters.has(kind)) continue;
+
+                std::fprintf(file, "%s\"%s\": %.3f", separator, perf_sample_t::name(kind), result.counters.per_operation(kind, result.operations));
+                separator = ", ";
+            }
+            std::fprintf(file, "}");
+        }
+        std::fprintf(file, "}%s\n", index + 1 == results.size() ? "" : ",");
+    }
+    std::fprintf(file, "  ]\n");
+    std::fprintf(file, "}\n");
+}
+
+int main(int argc, char* argv[])
+{
+    auto const scale = argc > 2 ? static_cast<std::size_t>(std::max(std::atoi(argv[2]), 1)) : std::size_t(1);
+
+    struct workload_t
+    {
+        char const* name;
+        script_t (*make)(std::size_t);
+    };
+
+    workload_t const workloads[] =
+    {
+        {"random_sizes", make_random_sizes},
+        {"lifo", make_lifo},
+        {"fifo", make_fifo},
+        {"realloc_heavy", make_realloc_heavy},
+        {"fragmentation", make_fragmentation},
+        {"long_tail", make_long_tail},
+    };
+
+    perf_counters_t counters;
+    counters.open();
+
+    std::vector<result_t> results;
+    for (auto const& workload : workloads)
+    {
+        auto const script = workload.make(scale);
+        results.push_back(measure_script<manager_target_t>(workload.name, script, counters));
+        results.push_back(measure_script<malloc_target_t>(workload.name, script, counters));
+    }
+    results.push_back(measure_producer_consumer<manager_target_t>(scale));
+    results.push_back(measure_producer_consumer<malloc_target_t>(scale));
+
+    for (std::size_t thread_count = 1; thread_count <= 8; thread_count *= 2)
+    {
+        results.push_back(measure_fixed_pool<pool_cache_target_t>(thread_count, scale));
+        results.push_back(measure_fixed_pool<mutex_pool_target_t>(thread_count, scale));
+    }
+
+    for (std::size_t thread_count = 1; thread_count <= 8; thread_count *= 2)
+    {
+        results.push_back(measure_counters<false>(thread_count, scale));
+        results.push_back(measure_counters<true>(thread_count, scale));
+    }
+
+    auto file = argc > 1 ? std::fopen(argv[1], "w") : stdout;
+    if (file == nullptr)
+    {
+        std::printf("error: cannot open '%s'\n", argv[1]);
+        return 1;
+    }
+
+    write_json(file, results, scale, counters.is_open());
+    if (file != stdout) std::fclose(file);
+    return 0;
+}
@@ -0,0 +1,115 @@
+#ifndef EIGHTMORY_CACHE_HPP
+#define EIGHTMORY_CACHE_HPP
+
+#include <Eightmory/Core.hpp>
+
+#include <cstddef> // size_t
+#include <cstdint> // uintptr_t
+#include <cstring> // memcpy
+#include <bit> // bit_ceil
+
+namespace eightmory
+{
+
+inline constexpr auto cache_line_bytes = std::size_t(64);
+
+// return 'pointer to segment memory' of memory returned by add_aligned_segment
+inline void* aligned_segment_memory(void* memory) noexcept
+{
+    std::size_t offset = 0;
+    std::memcpy(&offset, static_cast<char*>(memory) - sizeof(offset), sizeof(offset));
+    return static_cast<char*>(memory) - offset;
+}
+
+// allocate memory of given size, which starts offset bytes after align boundary
+// distance to segment memory is stored in word before returned memory
+// align must be power of two
+// return 'pointer to memory' or 'nullptr'
+template <typename ManagerType>
+[[nodiscard]] void* add_aligned_segment(ManagerType& manager, std::size_t size, std::size_t align, std::size_t offset = 0) noexcept
+{
+    auto const memory = static_cast<char*>(manager.add_segment(sizeof(std::size_t) + align - 1 + offset + size));
+    if (memory == nullptr)
+    {
+        return nullptr;
+    }
+
+    auto const address = static_cast<std::size_t>(reinterpret_cast<std::uintptr_t>(memory));
+    auto const aligned = memory + (align_up(address + sizeof(std::size_t), align) - address) + offset;
+
+    auto const distance = static_cast<std::size_t>(aligned - memory);
+    std::memcpy(aligned - sizeof(distance), &distance, sizeof(distance));
+    return aligned;
+}
+
+// return 'true' if removed
+template <typename ManagerType>
+bool remove_aligned_segment(ManagerType& manager, void* memory) noexcept
+{
+    return memory != nullptr && manager.remove_segment(aligned_segment_memory(memory));
+}
+
+// allocate memory, which owns all cache lines it touches, so it is never falsely shared with other segments
+// headers of segment and its rhs lie outside of these lines
+// return 'pointer to memory' or 'nullptr'
+template <typename ManagerType>
+[[nodiscard]] void* add_isolated_segment(ManagerType& manager, std::size_t size) noexcept
+{
+    return add_aligned_segment(manager, align_up(size == 0 ? 1 : size, cache_line_bytes), cache_line_bytes);
+}
+
+template <typename ManagerType>
+bool remove_isolated_segment(ManagerType& manager, void* memory) noexcept
+{
+    return remove_aligned_segment(manager, memory);
+}
+
+// offset slab starts by cycling colours, so equal size objects at same index of different slabs
+// map to different cache sets instead of competing for the same ones
+// slabs are aligned to colour_count cache lines, and colour is cache line offset from that boundary
+// slab may be used as memory of fixed_pool_t
+template <typename ManagerType>
+class slab_colouring_t
+{
+public:
+    using manager_type = ManagerType;
+
+public:
+    // colour_count is rounded up to power of two, 1 disables colouring and slabs are aligned to cache line only
+    explicit slab_colouring_t(manager_type& manager, std::size_t colour_count = 8) noexcept
+        : xxmanager(manager), xxcolour_count(std::bit_ceil(colour_count == 0 ? 1 : colour_count)) {}
+
+public:
+    // slab starts next_colour() cache lines after boundary of colour_count cache lines
+    // return 'pointer to slab memory' or 'nullptr'
+    [[nodiscard]] void* add_slab(std::size_t bytes) noexcept
+    {
+        auto memory = add_aligned_segment(xxmanager, bytes, xxcolour_count * cache_line_bytes, xxcolour * cache_line_bytes);
+        if (memory != nullptr)
+        {
+            xxcolour = (xxcolour + 1) % xxcolour_count;
+        }
+        return memory;
+    }
+
+    bool remove_slab(void* memory) noexcept
+    {
+        return remove_aligned_segment(xxmanager, memory);
+    }
+
+public:
+    std::size_t colour_count() const noexcept { return xxcolour_count; }
+    std::size_t next_colour() const noexcept { return xxcolour; }
+
+    manager_type& manager() const noexcept { return xxmanager; }
+
+private:
+    manager_type& xxmanager;
+
+    std::size_t xxcolour_count = 1;
+    std::size_t xxcolour = 0;
+};
+
+} // namespace eightmory
+
+#endif // EIGHTMORY_CACHE_HPP
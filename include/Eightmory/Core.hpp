@@ -2,48 +2,408 @@
 #define EIGHTMORY_CORE_HPP
 
 #include <cstddef> // size_t
+#include <cstdint> // uint32_t
 #include <climits> // CHAR_BIT
+#include <new> // placement new
+
+// in debug builds each manager, which is not copy of other one, allocates bitmap of heap bytes / 8 bytes
+// on construction and attach, so pointers passed to it are validated in O(1)
+#ifdef EIGHTMORY_DEBUG
+#include <memory> // shared_ptr
+#include <vector> // vector
+#endif // EIGHTMORY_DEBUG
 
 namespace eightmory
 {
 
-struct EIGHTMORY_API segment_t
+// SizeType defines header width and max heap size
+template <typename SizeType>
+struct basic_segment_t
 {
-    std::size_t size : sizeof(std::size_t) * CHAR_BIT - 1;
-    std::size_t is_used : 1;
+    SizeType size : sizeof(SizeType) * CHAR_BIT - 1;
+    SizeType is_used : 1;
 
-    static constexpr auto max_size = std::size_t(-1) >> 1;
+    static constexpr auto max_size = std::size_t(SizeType(-1) >> 1);
 
     // return 'pointer to segment memory' from 'segment'
-    void* memory() noexcept;
+    void* memory() noexcept
+    {
+        return reinterpret_cast<char*>(this) + sizeof(basic_segment_t);
+    }
 
     // return 'segment' from 'pointer to segment memory'
-    static segment_t* segment(void* memory) noexcept;
+    static basic_segment_t* segment(void* memory) noexcept
+    {
+        return reinterpret_cast<basic_segment_t*>
+        (
+            reinterpret_cast<char*>(memory) - sizeof(basic_segment_t)
+        );
+    }
+
+    basic_segment_t* next() noexcept
+    {
+        return reinterpret_cast<basic_segment_t*>
+        (
+            reinterpret_cast<char*>(memory()) + size
+        );
+    }
+};
+
+using segment_t = basic_segment_t<std::size_t>;
+
+// 4 bytes header for heaps less than 2 GiB
+using compact_segment_t = basic_segment_t<std::uint32_t>;
+
+// TagBits of size are taken by tag of used segment, so tag costs nothing per segment
+template <typename SizeType, std::size_t TagBits>
+struct basic_tagged_segment_t
+{
+    SizeType size : sizeof(SizeType) * CHAR_BIT - 1 - TagBits;
+    SizeType tag : TagBits;
+    SizeType is_used : 1;
+
+    static constexpr auto max_size = std::size_t(SizeType(-1) >> (1 + TagBits));
+    static constexpr auto max_tag = std::size_t((SizeType(1) << TagBits) - 1);
+
+    void* memory() noexcept
+    {
+        return reinterpret_cast<char*>(this) + sizeof(basic_tagged_segment_t);
+    }
+
+    static basic_tagged_segment_t* segment(void* memory) noexcept
+    {
+        return reinterpret_cast<basic_tagged_segment_t*>
+        (
+            reinterpret_cast<char*>(memory) - sizeof(basic_tagged_segment_t)
+        );
+    }
+
+    basic_tagged_segment_t* next() noexcept
+    {
+        return reinterpret_cast<basic_tagged_segment_t*>
+        (
+            reinterpret_cast<char*>(memory()) + size
+        );
+    }
+};
+
+// 256 tags for heaps less than 32 PiB
+using tagged_segment_t = basic_tagged_segment_t<std::size_t, 8>;
+
+// return 'tag of segment' or 0 for untagged segment types
+template <typename SegmentType>
+std::uint32_t segment_tag(SegmentType* segment) noexcept
+{
+    if constexpr (requires { segment->tag; })
+    {
+        return static_cast<std::uint32_t>(segment->tag);
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+// statistics are disabled, all events are compiled out
+struct no_stats_t
+{
+    template <typename SegmentType> void init(SegmentType*, SegmentType*) noexcept {}
+    template <typename SegmentType> void refresh(SegmentType*, SegmentType*) noexcept {}
+
+    void search() noexcept {}
+    void visit() noexcept {}
+    void fail() noexcept {}
+
+    template <typename SegmentType> void add(SegmentType*) noexcept {}
+    template <typename SegmentType> void split(SegmentType*, SegmentType*) noexcept {}
+    template <typename SegmentType> void merge(SegmentType*, std::size_t) noexcept {}
+    template <typename SegmentType> void move(SegmentType*, SegmentType*, std::size_t) noexcept {}
+    template <typename SegmentType> void remove(SegmentType*) noexcept {}
+    template <typename SegmentType> void append(SegmentType*) noexcept {}
+};
+
+// hooks are disabled, all events are compiled out
+// tag is 0 for untagged segments
+struct no_hooks_t
+{
+    void allocate(void*, std::size_t, std::uint32_t) noexcept {}
+    void free(void*, std::size_t, std::uint32_t) noexcept {}
+    void extend(void*, std::size_t, std::uint32_t) noexcept {}
+    void coalesce(void*, std::size_t) noexcept {}
+};
+
+#ifdef EIGHTMORY_DEBUG
+// debug only side bitmap of segment headers, one bit per byte of heap
+// shared by copies of manager, since they work over same heap
+// if bitmap cannot be allocated, headers are not tracked and validation is reduced to range checks,
+// which is reported by is_segment_tracking of manager
+class segment_starts_t
+{
+public:
+    bool is_tracked() const noexcept { return xxbits != nullptr; }
+
+    void clear() noexcept { xxbits = nullptr; }
+
+    void reset(void const* begin, std::size_t bytes) noexcept
+    {
+        xxbegin = static_cast<char const*>(begin);
+        try
+        {
+            xxbits = std::make_shared<std::vector<unsigned char>>((bytes + CHAR_BIT - 1) / CHAR_BIT);
+        }
+        catch (...)
+        {
+            xxbits = nullptr;
+        }
+    }
+
+    void grow(std::size_t bytes) noexcept
+    {
+        if (xxbits == nullptr) return;
+        try
+        {
+            xxbits->resize((bytes + CHAR_BIT - 1) / CHAR_BIT);
+        }
+        catch (...)
+        {
+            xxbits = nullptr;
+        }
+    }
+
+    void set(void const* header, bool is_start) noexcept
+    {
+        auto const offset = static_cast<std::size_t>(static_cast<char const*>(header) - xxbegin);
+        if (xxbits != nullptr && offset / CHAR_BIT < xxbits->size())
+        {
+            auto& bits = (*xxbits)[offset / CHAR_BIT];
+            auto const mask = static_cast<unsigned char>(1u << (offset % CHAR_BIT));
+            bits = static_cast<unsigned char>(is_start ? bits | mask : bits & ~mask);
+        }
+    }
+
+    // return 'true' if header is known segment header
+    bool test(void const* header) const noexcept
+    {
+        auto const offset = static_cast<std::size_t>(static_cast<char const*>(header) - xxbegin);
+        return xxbits != nullptr && offset / CHAR_BIT < xxbits->size() && ((*xxbits)[offset / CHAR_BIT] >> (offset % CHAR_BIT) & 1u) != 0;
+    }
+
+private:
+    char const* xxbegin = nullptr;
+    std::shared_ptr<std::vector<unsigned char>> xxbits;
+};
+#endif // EIGHTMORY_DEBUG
+
+// forward events of policies to stats, and merges to hooks as coalesce
+// in debug builds also track created and destroyed headers
+template <typename StatsPolicy, typename HooksPolicy>
+struct segment_events_t
+{
+    StatsPolicy& stats;
+    HooksPolicy& hooks;
+#ifdef EIGHTMORY_DEBUG
+    segment_starts_t* starts = nullptr;
+#endif // EIGHTMORY_DEBUG
+
+    void search() noexcept { stats.search(); }
+    void visit() noexcept { stats.visit(); }
+    void fail() noexcept { stats.fail(); }
+
+    template <typename SegmentType> void add(SegmentType* segment) noexcept { stats.add(segment); }
+    template <typename SegmentType> void split(SegmentType* segment, SegmentType* created) noexcept
+    {
+        stats.split(segment, created);
+#ifdef EIGHTMORY_DEBUG
+        starts->set(created, true);
+#endif // EIGHTMORY_DEBUG
+    }
 
-    segment_t* next() noexcept;
+    template <typename SegmentType> void merge(SegmentType* segment, std::size_t rhs_size) noexcept
+    {
+        stats.merge(segment, rhs_size);
+        hooks.coalesce(segment->memory(), segment->size);
+#ifdef EIGHTMORY_DEBUG
+        starts->set(reinterpret_cast<char*>(segment->next()) - rhs_size - sizeof(SegmentType), false);
+#endif // EIGHTMORY_DEBUG
+    }
+
+    // rhs header is moved by size bytes to created
+    template <typename SegmentType> void move(SegmentType* segment, SegmentType* created, std::size_t size) noexcept
+    {
+        stats.move(segment, created, size);
+#ifdef EIGHTMORY_DEBUG
+        starts->set(reinterpret_cast<char*>(created) - size, false);
+        starts->set(created, true);
+#endif // EIGHTMORY_DEBUG
+    }
+    template <typename SegmentType> void remove(SegmentType* segment) noexcept { stats.remove(segment); }
+
+    // free segment is appended by extend_heap
+    template <typename SegmentType> void append(SegmentType* segment) noexcept
+    {
+        stats.append(segment);
+#ifdef EIGHTMORY_DEBUG
+        starts->set(segment, true);
+#endif // EIGHTMORY_DEBUG
+    }
+};
+
+// merge free rhs segment into segment
+// return 'true' if merged
+template <typename SegmentType, typename StatsPolicy>
+bool extend_segment_with_rhs(SegmentType* end, SegmentType* segment, StatsPolicy& stats) noexcept
+{
+    auto rhs = segment->next();
+    if (rhs == end || rhs->is_used)
+    {
+        return false;
+    }
+    else
+    {
+        std::size_t const rhs_size = rhs->size;
+
+        segment->size += sizeof(SegmentType) + rhs->size;
+        rhs->~SegmentType();
+
+        stats.merge(segment, rhs_size);
+        return true;
+    }
+}
+
+// merge free rhs segments only while searching
+struct lazy_coalesce_t
+{
+    // grow free segment up to size, if possible
+    template <typename SegmentType, typename StatsPolicy>
+    static void search(SegmentType* end, SegmentType* segment, std::size_t size, StatsPolicy& stats) noexcept
+    {
+        // lazy defragmentation
+        while
+        (
+            segment->size < size && extend_segment_with_rhs(end, segment, stats)
+        );
+    }
+
+    template <typename SegmentType, typename StatsPolicy>
+    static void remove(SegmentType*, SegmentType*, StatsPolicy&) noexcept {}
+};
+
+// also merge free rhs segments into removed segment
+struct eager_coalesce_t : lazy_coalesce_t
+{
+    template <typename SegmentType, typename StatsPolicy>
+    static void remove(SegmentType* end, SegmentType* segment, StatsPolicy& stats) noexcept
+    {
+        while
+        (
+            extend_segment_with_rhs(end, segment, stats)
+        );
+    }
+};
+
+// take first free segment of enough size
+struct first_fit_t
+{
+    template <typename CoalescePolicy, typename SegmentType, typename StatsPolicy>
+    static SegmentType* find(SegmentType* hint, SegmentType* end, std::size_t size, StatsPolicy& stats) noexcept
+    {
+        for (auto segment = hint; segment != end; segment = segment->next())
+        {
+            stats.visit();
+            if (segment->is_used)
+            {
+                continue;
+            }
+
+            CoalescePolicy::search(end, segment, size, stats);
+            if (segment->size >= size)
+            {
+                return segment;
+            }
+        }
+        return nullptr;
+    }
 };
 
-class EIGHTMORY_API segment_manager_t
+// take smallest free segment of enough size, always walk up to end unless exact size found
+struct best_fit_t
+{
+    template <typename CoalescePolicy, typename SegmentType, typename StatsPolicy>
+    static SegmentType* find(SegmentType* hint, SegmentType* end, std::size_t size, StatsPolicy& stats) noexcept
+    {
+        SegmentType* best = nullptr;
+        for (auto segment = hint; segment != end; segment = segment->next())
+        {
+            stats.visit();
+            if (segment->is_used)
+            {
+                continue;
+            }
+
+            CoalescePolicy::search(end, segment, size, stats);
+            if (segment->size >= size && (best == nullptr || segment->size < best->size))
+            {
+                best = segment;
+                if (best->size == size)
+                {
+                    break;
+                }
+            }
+        }
+        return best;
+    }
+};
+
+// header only, all policies are resolved at compile time
+template
+<
+    typename FitPolicy = first_fit_t,
+    typename CoalescePolicy = lazy_coalesce_t,
+    typename SegmentType = segment_t,
+    typename StatsPolicy = no_stats_t,
+    typename HooksPolicy = no_hooks_t
+>
+class basic_segment_manager_t
 {
 public:
-    segment_manager_t(void* memory, std::size_t bytes) noexcept;
+    using fit_policy = FitPolicy;
+    using coalesce_policy = CoalescePolicy;
+    using segment_type = SegmentType;
+    using stats_policy = StatsPolicy;
+    using hooks_policy = HooksPolicy;
+
+public:
+    // debug builds allocate bitmap of bytes / 8 bytes, see EIGHTMORY_DEBUG
+    basic_segment_manager_t(void* memory, std::size_t bytes) noexcept;
+
+    // adopt already initialized segments without overriding them
+    // segments layout is position independent, so memory can be remapped
+    static basic_segment_manager_t attach(void* memory, std::size_t bytes) noexcept;
+
+private:
+    basic_segment_manager_t() noexcept = default;
 
 public:
-    // allocate segment of given size in range [size, size + sizeof(segment_t))
+    // allocate segment of given size in range [size, size + sizeof(segment_type))
     // search from begin
     // return 'pointer to segment memory'
     [[nodiscard]] void* add_segment(std::size_t size) noexcept;
 
-    // allocate segment of given size in range [size, size + sizeof(segment_t))
+    // allocate segment of given size in range [size, size + sizeof(segment_type))
     // search from hint
     // return 'pointer to segment memory'
-    [[nodiscard]] void* add_segment(std::size_t size, segment_t* hint) noexcept;
+    [[nodiscard]] void* add_segment(std::size_t size, segment_type* hint) noexcept;
+
+    // allocate segment of given size in range [size, size + sizeof(segment_type))
+    // search from hint, tag is stored by tagged segment types only
+    // return 'pointer to segment memory' or 'nullptr' if tag is greater than max_tag of tagged segment type
+    [[nodiscard]] void* add_segment(std::size_t size, segment_type* hint, std::uint32_t tag) noexcept;
 
     // extend segment using available free rhs segments
     // return 'true' if extened
     bool extend_segment(void* memory) noexcept;
 
-    // extend segment of given extra size in range [size, size + sizeof(segment_t))
+    // extend segment of given extra size in range [size, size + sizeof(segment_type))
     // return 'true' if extended
     bool extend_segment(void* memory, std::size_t size) noexcept;
 
@@ -51,16 +411,393 @@ public:
     // return 'true' if removed
     bool remove_segment(void* memory) noexcept;
 
+    // append bytes after end to heap as free segment, memory after end must be owned by caller
+    // stats are updated by append event in O(1)
+    // return 'true' if extended
+    bool extend_heap(std::size_t bytes) noexcept;
+
+    // merge all runs of free segments, including ones, which lazy search would start in the middle of
+    // return 'size of largest free segment'
+    std::size_t coalesce() noexcept;
+
 public:
-    segment_t* begin() const noexcept { return xxbegin; }
-    segment_t* end() const noexcept { return xxend; }
+    segment_type* begin() const noexcept { return xxbegin; }
+    segment_type* end() const noexcept { return xxend; }
     std::size_t bytes() const noexcept;
 
+public:
+    stats_policy const& stats() const noexcept { return xxstats; }
+
+    // return 'copy of stats' with all values up to date
+    stats_policy snapshot() noexcept;
+
+    hooks_policy& hooks() noexcept { return xxhooks; }
+    hooks_policy const& hooks() const noexcept { return xxhooks; }
+
+public:
+    // heap is changed by other managers too, like ones of other processes over shared memory,
+    // so segments are not tracked by this manager, and debug validation is reduced to range checks
+    void disable_segment_tracking() noexcept
+    {
+#ifdef EIGHTMORY_DEBUG
+        xxstarts.clear();
+#endif // EIGHTMORY_DEBUG
+    }
+
+    // return 'true' if debug validation knows all segment headers, 'false' in release builds,
+    // after disable_segment_tracking or if bitmap of headers cannot be allocated
+    bool is_segment_tracking() const noexcept
+    {
+#ifdef EIGHTMORY_DEBUG
+        return xxstarts.is_tracked();
+#else
+        return false;
+#endif // EIGHTMORY_DEBUG
+    }
+
+private:
+#ifdef EIGHTMORY_DEBUG
+    segment_events_t<stats_policy, hooks_policy> events() noexcept { return {xxstats, xxhooks, &xxstarts}; }
+#else
+    segment_events_t<stats_policy, hooks_policy> events() noexcept { return {xxstats, xxhooks}; }
+#endif // EIGHTMORY_DEBUG
+
+    // O(1) check of range, of segment and rhs headers consistency and, in debug builds, of known headers bitmap
+    // return 'true' if memory is segment memory
+    bool is_valid_memory(void* memory) const noexcept;
+
 private:
-    segment_t* xxbegin = nullptr;
-    segment_t* xxend = nullptr;
+    segment_type* xxbegin = nullptr;
+    segment_type* xxend = nullptr;
+
+    [[no_unique_address]] stats_policy xxstats;
+    [[no_unique_address]] hooks_policy xxhooks;
+
+#ifdef EIGHTMORY_DEBUG
+    segment_starts_t xxstarts;
+#endif // EIGHTMORY_DEBUG
 };
 
+using segment_manager_t = basic_segment_manager_t<first_fit_t, lazy_coalesce_t, segment_t>;
+using compact_segment_manager_t = basic_segment_manager_t<first_fit_t, lazy_coalesce_t, compact_segment_t>;
+
+template <typename FitPolicy, typename CoalescePolicy, typename SegmentType, typename StatsPolicy, typename HooksPolicy>
+basic_segment_manager_t<FitPolicy, CoalescePolicy, SegmentType, StatsPolicy, HooksPolicy>::basic_segment_manager_t(void* memory, std::size_t bytes) noexcept
+{
+    // buffer size must be greater than sizeof(segment_type)
+    if (bytes >= sizeof(segment_type) && bytes <= segment_type::max_size)
+    {
+        xxbegin = reinterpret_cast<segment_type*>(memory);
+        xxend = reinterpret_cast<segment_type*>(reinterpret_cast<char*>(memory) + bytes);
+
+        auto segment = new (begin()) segment_type;
+        segment->size = bytes - sizeof(segment_type);
+        segment->is_used = false;
+
+        xxstats.init(begin(), end());
+#ifdef EIGHTMORY_DEBUG
+        xxstarts.reset(begin(), bytes);
+        xxstarts.set(begin(), true);
+#endif // EIGHTMORY_DEBUG
+    }
+}
+
+template <typename FitPolicy, typename CoalescePolicy, typename SegmentType, typename StatsPolicy, typename HooksPolicy>
+auto basic_segment_manager_t<FitPolicy, CoalescePolicy, SegmentType, StatsPolicy, HooksPolicy>::attach(void* memory, std::size_t bytes) noexcept -> basic_segment_manager_t
+{
+    basic_segment_manager_t manager;
+    if (bytes >= sizeof(segment_type) && bytes <= segment_type::max_size)
+    {
+        manager.xxbegin = reinterpret_cast<segment_type*>(memory);
+        manager.xxend = reinterpret_cast<segment_type*>(reinterpret_cast<char*>(memory) + bytes);
+
+        manager.xxstats.init(manager.begin(), manager.end());
+#ifdef EIGHTMORY_DEBUG
+        // attached heap may be broken, so walk stops at first header, which does not fit heap
+        manager.xxstarts.reset(manager.begin(), bytes);
+        for (auto segment = manager.begin(); segment < manager.end(); segment = segment->next())
+        {
+            auto const rest = static_cast<std::size_t>(reinterpret_cast<char*>(manager.end()) - reinterpret_cast<char*>(segment));
+            if (rest < sizeof(segment_type))
+            {
+                break;
+            }
+
+            manager.xxstarts.set(segment, true);
+            if (segment->size > rest - sizeof(segment_type))
+            {
+                break;
+            }
+        }
+#endif // EIGHTMORY_DEBUG
+    }
+    return manager;
+}
+
+template <typename FitPolicy, typename CoalescePolicy, typename SegmentType, typename StatsPolicy, typename HooksPolicy>
+void* basic_segment_manager_t<FitPolicy, CoalescePolicy, SegmentType, StatsPolicy, HooksPolicy>::add_segment(std::size_t size) noexcept
+{
+    return add_segment(size, begin());
+}
+
+template <typename FitPolicy, typename CoalescePolicy, typename SegmentType, typename StatsPolicy, typename HooksPolicy>
+void* basic_segment_manager_t<FitPolicy, CoalescePolicy, SegmentType, StatsPolicy, HooksPolicy>::add_segment(std::size_t size, segment_type* hint) noexcept
+{
+    return add_segment(size, hint, 0);
+}
+
+template <typename FitPolicy, typename CoalescePolicy, typename SegmentType, typename StatsPolicy, typename HooksPolicy>
+void* basic_segment_manager_t<FitPolicy, CoalescePolicy, SegmentType, StatsPolicy, HooksPolicy>::add_segment(std::size_t size, segment_type* hint, std::uint32_t tag) noexcept
+{
+    // tag would be masked into other tag by bit field
+    if constexpr (requires { segment_type::max_tag; })
+    {
+        if (tag > segment_type::max_tag)
+        {
+            return nullptr;
+        }
+    }
+
+    auto events = this->events();
+    events.search();
+
+    auto segment = FitPolicy::template find<CoalescePolicy>(hint, end(), size, events);
+    if (segment == nullptr)
+    {
+        events.fail();
+        return nullptr;
+    }
+
+    if (segment->size >= sizeof(segment_type) + size)
+    {
+        const auto diff = segment->size - size;
+
+        segment->size = size;
+
+        auto created = new (segment->next()) segment_type;
+
+        created->size = diff - sizeof(segment_type);
+        created->is_used = false;
+
+        events.split(segment, created);
+    }
+    // sama as segment->size >= size && segment->size < size + sizeof(segment_type)
+
+    segment->is_used = true;
+    if constexpr (requires { segment->tag; })
+    {
+        segment->tag = tag;
+    }
+    else
+    {
+        (void)tag;
+    }
+    events.add(segment);
+
+    xxhooks.allocate(segment->memory(), segment->size, tag);
+    return segment->memory();
+}
+
+template <typename FitPolicy, typename CoalescePolicy, typename SegmentType, typename StatsPolicy, typename HooksPolicy>
+bool basic_segment_manager_t<FitPolicy, CoalescePolicy, SegmentType, StatsPolicy, HooksPolicy>::is_valid_memory(void* memory) const noexcept
+{
+    auto const address = reinterpret_cast<char*>(memory);
+    auto const end_address = reinterpret_cast<char*>(end());
+    if (begin() == nullptr || address < begin()->memory() || address > end_address)
+    {
+        return false;
+    }
+
+    // segment must fit in heap
+    auto const segment = segment_type::segment(memory);
+    if (segment->size > static_cast<std::size_t>(end_address - address))
+    {
+        return false;
+    }
+
+    // rhs header must be whole and fit in heap too
+    auto const rhs = segment->next();
+    if (rhs != end())
+    {
+        auto const rhs_address = reinterpret_cast<char*>(rhs);
+        if
+        (
+            static_cast<std::size_t>(end_address - rhs_address) < sizeof(segment_type) ||
+            rhs->size > static_cast<std::size_t>(end_address - rhs_address) - sizeof(segment_type)
+        )
+        {
+            return false;
+        }
+    }
+
+#ifdef EIGHTMORY_DEBUG
+    // payload may look like consistent headers, zeros do, so only tracked headers are accepted
+    return !xxstarts.is_tracked() || xxstarts.test(segment);
+#else
+    return true;
+#endif // EIGHTMORY_DEBUG
+}
+
+template <typename FitPolicy, typename CoalescePolicy, typename SegmentType, typename StatsPolicy, typename HooksPolicy>
+bool basic_segment_manager_t<FitPolicy, CoalescePolicy, SegmentType, StatsPolicy, HooksPolicy>::extend_segment(void* memory) noexcept
+{
+#ifdef EIGHTMORY_DEBUG
+    if (!is_valid_memory(memory))
+    {
+        return false;
+    }
+#endif // EIGHTMORY_DEBUG
+    auto events = this->events();
+    auto segment = segment_type::segment(memory);
+    auto const prev_size = segment->size;
+
+    while
+    (
+        extend_segment_with_rhs(end(), segment, events)
+    );
+
+    if (segment->size > prev_size)
+    {
+        xxhooks.extend(memory, segment->size, segment_tag(segment));
+        return true;
+    }
+    return false;
+}
+
+template <typename FitPolicy, typename CoalescePolicy, typename SegmentType, typename StatsPolicy, typename HooksPolicy>
+bool basic_segment_manager_t<FitPolicy, CoalescePolicy, SegmentType, StatsPolicy, HooksPolicy>::extend_segment(void* memory, std::size_t size) noexcept
+{
+#ifdef EIGHTMORY_DEBUG
+    if (!is_valid_memory(memory))
+    {
+        return false;
+    }
+#endif // EIGHTMORY_DEBUG
+    auto events = this->events();
+    auto segment = segment_type::segment(memory);
+    auto rhs = segment->next();
+
+    if (rhs == end() || rhs->is_used)
+    {
+        return false;
+    }
+
+    while
+    (
+        rhs->size < size && extend_segment_with_rhs(end(), rhs, events)
+    );
+
+    if (rhs->size >= size)
+    {
+        const auto diff = rhs->size - size;
+
+        segment->size += size;
+        rhs->~segment_type();
+
+        auto created = new (segment->next()) segment_type;
+
+        created->size = diff;
+        created->is_used = false;
+
+        events.move(segment, created, size);
+
+        xxhooks.extend(memory, segment->size, segment_tag(segment));
+        return true;
+    }
+    // same as rhs->size >= size - sizeof(segment_type) && rhs->size < size
+    else if (sizeof(segment_type) + rhs->size >= size)
+    {
+        extend_segment_with_rhs(end(), segment, events);
+
+        xxhooks.extend(memory, segment->size, segment_tag(segment));
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+template <typename FitPolicy, typename CoalescePolicy, typename SegmentType, typename StatsPolicy, typename HooksPolicy>
+bool basic_segment_manager_t<FitPolicy, CoalescePolicy, SegmentType, StatsPolicy, HooksPolicy>::remove_segment(void* memory) noexcept
+{
+#ifdef EIGHTMORY_DEBUG
+    // also catch double free
+    if (!is_valid_memory(memory) || !segment_type::segment(memory)->is_used)
+    {
+        return false;
+    }
+#endif // EIGHTMORY_DEBUG
+    auto events = this->events();
+    auto segment = segment_type::segment(memory);
+    xxhooks.free(memory, segment->size, segment_tag(segment));
+
+    segment->is_used = false;
+    events.remove(segment);
+
+    CoalescePolicy::remove(end(), segment, events);
+    return true;
+}
+
+template <typename FitPolicy, typename CoalescePolicy, typename SegmentType, typename StatsPolicy, typename HooksPolicy>
+bool basic_segment_manager_t<FitPolicy, CoalescePolicy, SegmentType, StatsPolicy, HooksPolicy>::extend_heap(std::size_t bytes) noexcept
+{
+    if (begin() == nullptr || bytes < sizeof(segment_type) || bytes > segment_type::max_size - this->bytes())
+    {
+        return false;
+    }
+
+    auto segment = new (end()) segment_type;
+    segment->size = bytes - sizeof(segment_type);
+    segment->is_used = false;
+
+    xxend = reinterpret_cast<segment_type*>(reinterpret_cast<char*>(end()) + bytes);
+
+#ifdef EIGHTMORY_DEBUG
+    xxstarts.grow(this->bytes());
+#endif // EIGHTMORY_DEBUG
+    events().append(segment);
+    return true;
+}
+
+template <typename FitPolicy, typename CoalescePolicy, typename SegmentType, typename StatsPolicy, typename HooksPolicy>
+std::size_t basic_segment_manager_t<FitPolicy, CoalescePolicy, SegmentType, StatsPolicy, HooksPolicy>::coalesce() noexcept
+{
+    auto events = this->events();
+    auto largest = std::size_t(0);
+    for (auto segment = begin(); segment != end(); segment = segment->next())
+    {
+        if (segment->is_used)
+        {
+            continue;
+        }
+
+        while
+        (
+            extend_segment_with_rhs(end(), segment, events)
+        );
+
+        if (segment->size > largest)
+        {
+            largest = segment->size;
+        }
+    }
+    return largest;
+}
+
+template <typename FitPolicy, typename CoalescePolicy, typename SegmentType, typename StatsPolicy, typename HooksPolicy>
+std::size_t basic_segment_manager_t<FitPolicy, CoalescePolicy, SegmentType, StatsPolicy, HooksPolicy>::bytes() const noexcept
+{
+    return reinterpret_cast<char*>(end()) - reinterpret_cast<char*>(begin());
+}
+
+template <typename FitPolicy, typename CoalescePolicy, typename SegmentType, typename StatsPolicy, typename HooksPolicy>
+StatsPolicy basic_segment_manager_t<FitPolicy, CoalescePolicy, SegmentType, StatsPolicy, HooksPolicy>::snapshot() noexcept
+{
+    xxstats.refresh(begin(), end());
+    return xxstats;
+}
+
 // align must be power of two
 constexpr std::size_t align_up(std::size_t size, std::size_t align = alignof(segment_t)) noexcept
 {
@@ -0,0 +1,78 @@
+#ifndef EIGHTMORY_COUNTERS_HPP
+#define EIGHTMORY_COUNTERS_HPP
+
+#include <cstddef> // size_t
+#include <cstdint> // uint64_t
+
+namespace eightmory
+{
+
+enum class perf_counter_t : std::size_t
+{
+    cycles,
+    instructions,
+    l1d_misses,
+    llc_misses,
+    branch_misses,
+};
+
+struct perf_sample_t
+{
+    static constexpr auto counter_count = std::size_t(5);
+
+    // values are scaled up if kernel multiplexed counters
+    std::uint64_t values[counter_count] = {};
+    bool is_available[counter_count] = {};
+
+    std::uint64_t value(perf_counter_t counter) const noexcept { return values[std::size_t(counter)]; }
+    bool has(perf_counter_t counter) const noexcept { return is_available[std::size_t(counter)]; }
+
+    // return 'value per operation' or 0 if counter is not available
+    double per_operation(perf_counter_t counter, std::size_t operations) const noexcept
+    {
+        return has(counter) && operations != 0 ? double(value(counter)) / double(operations) : 0.0;
+    }
+
+    static char const* name(perf_counter_t counter) noexcept
+    {
+        constexpr char const* names[counter_count] = {"cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses"};
+        return names[std::size_t(counter)];
+    }
+};
+
+// hardware counters of calling thread in user space, read by perf_event_open on Linux
+// on other platforms or without permissions open fails and nothing is counted
+class EIGHTMORY_API perf_counters_t
+{
+public:
+    perf_counters_t() noexcept = default;
+    ~perf_counters_t();
+
+    perf_counters_t(perf_counters_t const&) = delete;
+    perf_counters_t& operator=(perf_counters_t const&) = delete;
+
+public:
+    // return 'true' if at least one counter is available
+    bool open() noexcept;
+    void close() noexcept;
+
+    // reset and enable all counters
+    // return 'true' if started
+    bool start() noexcept;
+
+    // return 'true' if stopped
+    bool stop() noexcept;
+
+    // return 'true' if sample was read
+    bool read(perf_sample_t& sample) const noexcept;
+
+    bool is_open() const noexcept { return xxleader != -1; }
+
+private:
+    int xxfiles[perf_sample_t::counter_count] = {-1, -1, -1, -1, -1};
+    int xxleader = -1;
+};
+
+} // namespace eightmory
+
+#endif // EIGHTMORY_COUNTERS_HPP
@@ -0,0 +1,134 @@
+#ifndef EIGHTMORY_DUMP_HPP
+#define EIGHTMORY_DUMP_HPP
+
+#include <Eightmory/Core.hpp>
+
+#include <cstddef> // size_t
+#include <cstdint> // uint64_t, uint32_t
+#include <cstdio> // FILE
+
+namespace eightmory
+{
+
+struct segment_info_t
+{
+    // offset of segment header from heap begin
+    std::size_t offset = 0;
+    std::size_t size = 0;
+    bool is_used = false;
+    std::uint32_t tag = 0;
+};
+
+// walk segments in address order with bounds checking, visitor is called with segment_info_t
+// return 'true' if all segments are valid, 'false' if walk was stopped on broken segment
+template <typename ManagerType, typename VisitorType>
+bool walk_segments(ManagerType const& manager, VisitorType&& visitor) noexcept
+{
+    using segment_type = typename ManagerType::segment_type;
+
+    auto const begin = reinterpret_cast<char*>(manager.begin());
+    auto const end = reinterpret_cast<char*>(manager.end());
+    for (auto segment = manager.begin(); segment != manager.end(); segment = segment->next())
+    {
+        auto const rest = static_cast<std::size_t>(end - reinterpret_cast<char*>(segment));
+        if (rest < sizeof(segment_type) || segment->size > rest - sizeof(segment_type))
+        {
+            return false;
+        }
+
+        segment_info_t info;
+        info.offset = static_cast<std::size_t>(reinterpret_cast<char*>(segment) - begin);
+        info.size = segment->size;
+        info.is_used = segment->is_used;
+        info.tag = segment->is_used ? segment_tag(segment) : 0;
+        visitor(static_cast<segment_info_t const&>(info));
+    }
+    return true;
+}
+
+// binary dump layout, all values are little endian:
+// [magic 8] [version 4] [segment_bytes 4] [bytes 8] [count 8]
+// count of [offset 8] [size 8, is_used in high bit] [tag 4] [reserved 4]
+struct segment_dump_header_t
+{
+    std::uint32_t version = 0;
+    std::uint32_t segment_bytes = 0;
+    std::uint64_t bytes = 0;
+    std::uint64_t count = 0;
+
+    static constexpr char magic[8] = {'8', 'M', 'R', 'Y', 'D', 'U', 'M', 'P'};
+    static constexpr std::uint32_t current_version = 1;
+    static constexpr std::size_t header_bytes = 32;
+    static constexpr std::size_t record_bytes = 24;
+};
+
+class EIGHTMORY_API segment_dump_writer_t
+{
+public:
+    segment_dump_writer_t() noexcept = default;
+    ~segment_dump_writer_t();
+
+    segment_dump_writer_t(segment_dump_writer_t const&) = delete;
+    segment_dump_writer_t& operator=(segment_dump_writer_t const&) = delete;
+
+public:
+    // return 'true' if opened
+    bool open(char const* path, std::size_t segment_bytes, std::size_t bytes) noexcept;
+
+    // return 'true' if written
+    bool write(segment_info_t const& info) noexcept;
+
+    // write segments count and close file
+    // return 'true' if all data was written
+    bool close() noexcept;
+
+private:
+    std::FILE* xxfile = nullptr;
+    std::uint64_t xxcount = 0;
+    bool xxis_failed = false;
+};
+
+class EIGHTMORY_API segment_dump_reader_t
+{
+public:
+    segment_dump_reader_t() noexcept = default;
+    ~segment_dump_reader_t();
+
+    segment_dump_reader_t(segment_dump_reader_t const&) = delete;
+    segment_dump_reader_t& operator=(segment_dump_reader_t const&) = delete;
+
+public:
+    // return 'true' if opened and header is valid
+    bool open(char const* path) noexcept;
+
+    // return 'true' if segment was read, 'false' at end of dump or on error
+    bool read(segment_info_t& info) noexcept;
+
+    void close() noexcept;
+
+    segment_dump_header_t const& header() const noexcept { return xxheader; }
+
+private:
+    std::FILE* xxfile = nullptr;
+    segment_dump_header_t xxheader;
+    std::uint64_t xxread_count = 0;
+};
+
+// write all segments of manager to file
+// return 'true' if dumped, dump of broken heap contains valid segments only and 'false' is returned
+template <typename ManagerType>
+bool dump_segments(ManagerType const& manager, char const* path) noexcept
+{
+    segment_dump_writer_t writer;
+    if (!writer.open(path, sizeof(typename ManagerType::segment_type), manager.bytes()))
+    {
+        return false;
+    }
+
+    auto const is_valid = walk_segments(manager, [&writer](segment_info_t const& info) { writer.write(info); });
+    return writer.close() && is_valid;
+}
+
+} // namespace eightmory
+
+#endif // EIGHTMORY_DUMP_HPP
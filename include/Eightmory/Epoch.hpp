@@ -0,0 +1,198 @@
+#ifndef EIGHTMORY_EPOCH_HPP
+#define EIGHTMORY_EPOCH_HPP
+
+#include <Eightmory/Core.hpp>
+#include <Eightmory/Lock.hpp>
+
+#include <cstddef> // size_t
+#include <cstdint> // uint64_t
+#include <atomic> // atomic
+
+namespace eightmory
+{
+
+// called with batch of retired memory, which is not reachable by any reader
+using epoch_reclaim_t = void (*)(void* context, void* const* memory, std::size_t count);
+
+// epoch-based reclamation: memory retired in epoch E is reclaimed after global epoch reaches E + 2,
+// since global epoch advances only when all readers in critical sections have observed it
+class EIGHTMORY_API epoch_domain_t
+{
+public:
+    static constexpr auto max_participants = std::size_t(64);
+
+public:
+    epoch_domain_t(epoch_reclaim_t reclaim, void* context) noexcept : xxreclaim(reclaim), xxcontext(context) {}
+
+    epoch_domain_t(epoch_domain_t const&) = delete;
+    epoch_domain_t& operator=(epoch_domain_t const&) = delete;
+
+public:
+    // advance global epoch if all active participants have observed it
+    // return 'true' if advanced
+    bool try_advance() noexcept;
+
+    std::uint64_t epoch() const noexcept { return xxepoch.load(std::memory_order_seq_cst); }
+
+private:
+    friend class epoch_participant_t;
+
+    // [epoch : 62] [active : 1] [used : 1], zero for free slot
+    struct alignas(64) slot_t
+    {
+        std::atomic<std::uint64_t> state{0};
+    };
+
+    static constexpr auto used_bit = std::uint64_t(1);
+    static constexpr auto active_bit = std::uint64_t(2);
+    static constexpr auto epoch_shift = 2;
+
+private:
+    alignas(64) std::atomic<std::uint64_t> xxepoch{0};
+    slot_t xxslots[max_participants];
+
+    epoch_reclaim_t xxreclaim = nullptr;
+    void* xxcontext = nullptr;
+};
+
+// registration of thread in domain with own list of retired memory
+// not thread-safe, each thread must use own participant
+class EIGHTMORY_API epoch_participant_t
+{
+public:
+    static constexpr auto capacity = std::size_t(256);
+    static constexpr auto reclaim_threshold = std::size_t(64);
+
+public:
+    // participant is not registered if domain has no free slot
+    explicit epoch_participant_t(epoch_domain_t& domain) noexcept;
+
+    // wait until all retired memory can be reclaimed, must be called outside of critical section
+    ~epoch_participant_t();
+
+    epoch_participant_t(epoch_participant_t const&) = delete;
+    epoch_participant_t& operator=(epoch_participant_t const&) = delete;
+
+public:
+    // begin critical section, memory read in it is not reclaimed until leave, may be nested
+    void enter() noexcept;
+    void leave() noexcept;
+
+    // defer reclamation of memory, which is already unreachable for new readers
+    // blocks until memory is reclaimed if list is full outside of critical section
+    // return 'false' if participant is not registered or list is full in critical section
+    bool retire(void* memory) noexcept;
+
+    // reclaim retired memory, which is not reachable by any reader
+    // return 'number of reclaimed pointers'
+    std::size_t reclaim() noexcept;
+
+    // wait for two epoch advances and reclaim all retired memory, must be called outside of critical section
+    void synchronize() noexcept;
+
+public:
+    bool is_registered() const noexcept { return xxslot != nullptr; }
+    bool is_active() const noexcept { return xxdepth != 0; }
+
+    std::size_t retired_count() const noexcept { return xxcount; }
+
+private:
+    epoch_domain_t& xxdomain;
+    epoch_domain_t::slot_t* xxslot = nullptr;
+    std::size_t xxdepth = 0;
+
+    // ordered by epoch of retire
+    void* xxmemory[capacity];
+    std::uint64_t xxepochs[capacity];
+    std::size_t xxcount = 0;
+};
+
+// scope of critical section
+class epoch_guard_t
+{
+public:
+    explicit epoch_guard_t(epoch_participant_t& participant) noexcept : xxparticipant(participant) { xxparticipant.enter(); }
+    ~epoch_guard_t() { xxparticipant.leave(); }
+
+    epoch_guard_t(epoch_guard_t const&) = delete;
+    epoch_guard_t& operator=(epoch_guard_t const&) = delete;
+
+private:
+    epoch_participant_t& xxparticipant;
+};
+
+// synchronized manager, which removes retired segments by batches under single lock
+// nodes of lock-free structures are added by add_segment, unlinked, retired by participant of domain
+template <typename ManagerType>
+class epoch_segment_manager_t
+{
+public:
+    using manager_type = ManagerType;
+    using segment_type = typename ManagerType::segment_type;
+
+public:
+    explicit epoch_segment_manager_t(manager_type& manager) noexcept : xxmanager(manager), xxdomain(&reclaim, this) {}
+
+    epoch_segment_manager_t(epoch_segment_manager_t const&) = delete;
+    epoch_segment_manager_t& operator=(epoch_segment_manager_t const&) = delete;
+
+public:
+    [[nodiscard]] void* add_segment(std::size_t size) noexcept
+    {
+        lock();
+        auto memory = xxmanager.add_segment(size);
+        unlock();
+        return memory;
+    }
+
+    // immediate remove, only for memory, which was never reachable by other threads
+    bool remove_segment(void* memory) noexcept
+    {
+        lock();
+        auto const removed = xxmanager.remove_segment(memory);
+        unlock();
+        return removed;
+    }
+
+    bool retire_segment(epoch_participant_t& participant, void* memory) noexcept
+    {
+        return participant.retire(memory);
+    }
+
+public:
+    manager_type& manager() const noexcept { return xxmanager; }
+    epoch_domain_t& domain() noexcept { return xxdomain; }
+
+    std::size_t reclaimed_count() const noexcept { return xxreclaimed_count.load(std::memory_order_relaxed); }
+
+public:
+    // manual synchronization for direct manager access
+    void lock() noexcept { xxlock.lock(); }
+    void unlock() noexcept { xxlock.unlock(); }
+
+private:
+    static void reclaim(void* context, void* const* memory, std::size_t count) noexcept
+    {
+        auto self = static_cast<epoch_segment_manager_t*>(context);
+
+        self->lock();
+        for (std::size_t index = 0; index < count; ++index)
+        {
+            self->xxmanager.remove_segment(memory[index]);
+        }
+        self->unlock();
+
+        self->xxreclaimed_count.fetch_add(count, std::memory_order_relaxed);
+    }
+
+private:
+    manager_type& xxmanager;
+    epoch_domain_t xxdomain;
+
+    alignas(64) spin_lock_t xxlock;
+    std::atomic<std::size_t> xxreclaimed_count{0};
+};
+
+} // namespace eightmory
+
+#endif // EIGHTMORY_EPOCH_HPP
@@ -0,0 +1,184 @@
+#ifndef EIGHTMORY_GUARDED_HPP
+#define EIGHTMORY_GUARDED_HPP
+
+#include <Eightmory/Core.hpp>
+
+#include <cstddef> // size_t
+#include <cstdint> // uint64_t, uint32_t
+#include <vector> // vector
+
+namespace eightmory
+{
+
+enum class guarded_fault_t
+{
+    none,
+    overflow,
+    underflow,
+    use_after_free,
+    wild_access,
+};
+
+struct guarded_report_t
+{
+    guarded_fault_t fault = guarded_fault_t::none;
+
+    // faulting address and nearest allocation
+    void const* address = nullptr;
+    void* memory = nullptr;
+    std::size_t size = 0;
+};
+
+// pool of single page slots, separated by inaccessible guard pages:
+// [guard] [slot] [guard] [slot] ... [guard]
+// allocation is right aligned against next guard page, so overflow traps at once
+// freed slot is made inaccessible and reused last, so use-after-free traps too
+class EIGHTMORY_API guarded_pool_t
+{
+public:
+    guarded_pool_t() noexcept = default;
+    ~guarded_pool_t();
+
+    guarded_pool_t(guarded_pool_t const&) = delete;
+    guarded_pool_t& operator=(guarded_pool_t const&) = delete;
+
+public:
+    // reserve slot_count slots with guard pages
+    // return 'true' if created
+    bool create(std::size_t slot_count) noexcept;
+    void close() noexcept;
+
+    // size must not be greater than page size, align must be power of two
+    // memory ends up to align - 1 bytes before guard page, so overflow into that slack is not trapped,
+    // align 1 gives byte exact overflow detection for memory without alignment requirements
+    // return 'pointer to memory', 'nullptr' if size is too big or all slots are used
+    [[nodiscard]] void* allocate(std::size_t size, std::size_t align = alignof(segment_t)) noexcept;
+
+    // return 'true' if memory was allocated by pool
+    bool deallocate(void* memory) noexcept;
+
+    bool contains(void const* memory) const noexcept
+    {
+        auto const address = reinterpret_cast<char const*>(memory);
+        return address >= xxbase && address < xxbase + xxbytes;
+    }
+
+    // return 'report' for address inside of pool
+    guarded_report_t describe(void const* address) const noexcept;
+
+    // install process-wide handler, which prints report of faults inside of pool to stderr
+    // and passes fault to previous handler, only one pool can be installed
+    // return 'true' if installed
+    bool install_fault_handler() noexcept;
+    void uninstall_fault_handler() noexcept;
+
+public:
+    std::size_t page_size() const noexcept { return xxpage_size; }
+    std::size_t slot_count() const noexcept { return xxslots.size(); }
+    std::size_t live_count() const noexcept { return xxlive_count; }
+
+private:
+    struct slot_t
+    {
+        std::size_t size = 0;
+        std::size_t offset = 0; // of memory from slot begin
+        bool is_used = false;
+        bool is_freed = false;
+    };
+
+private:
+    char* slot_memory(std::size_t index) const noexcept { return xxbase + (2 * index + 1) * xxpage_size; }
+
+private:
+    char* xxbase = nullptr;
+    std::size_t xxbytes = 0;
+    std::size_t xxpage_size = 0;
+
+    std::vector<slot_t> xxslots;
+
+    // free slots in order of release, so recently freed slot is reused last
+    std::vector<std::uint32_t> xxfree;
+    std::size_t xxfree_head = 0;
+    std::size_t xxfree_count = 0;
+
+    std::size_t xxlive_count = 0;
+};
+
+// routes one of about sample_rate allocations to guarded pool, other ones to manager
+// guarded allocations cannot be extended, so extend_segment fails for them
+template <typename ManagerType>
+class guarded_segment_manager_t
+{
+public:
+    using manager_type = ManagerType;
+    using segment_type = typename ManagerType::segment_type;
+
+public:
+    // sample_rate 0 disables sampling
+    guarded_segment_manager_t(manager_type& manager, guarded_pool_t& pool, std::size_t sample_rate = 1000, std::uint64_t seed = 0x8E16) noexcept
+        : xxmanager(manager), xxpool(pool), xxsample_rate(sample_rate), xxrandom(seed == 0 ? 1 : seed)
+    {
+        xxcountdown = next_countdown();
+    }
+
+public:
+    [[nodiscard]] void* add_segment(std::size_t size) noexcept
+    {
+        if (--xxcountdown == 0)
+        {
+            xxcountdown = next_countdown();
+            if (auto memory = xxpool.allocate(size))
+            {
+                return memory;
+            }
+        }
+        return xxmanager.add_segment(size);
+    }
+
+    bool extend_segment(void* memory) noexcept
+    {
+        return !xxpool.contains(memory) && xxmanager.extend_segment(memory);
+    }
+
+    bool extend_segment(void* memory, std::size_t size) noexcept
+    {
+        return !xxpool.contains(memory) && xxmanager.extend_segment(memory, size);
+    }
+
+    bool remove_segment(void* memory) noexcept
+    {
+        return xxpool.contains(memory) ? xxpool.deallocate(memory) : xxmanager.remove_segment(memory);
+    }
+
+public:
+    manager_type& manager() const noexcept { return xxmanager; }
+    guarded_pool_t& pool() const noexcept { return xxpool; }
+
+private:
+    // return 'allocations to next sample', uniform in [1, 2 * sample_rate]
+    std::size_t next_countdown() noexcept
+    {
+        if (xxsample_rate == 0)
+        {
+            return std::size_t(-1);
+        }
+
+        // xorshift64
+        xxrandom ^= xxrandom << 13;
+        xxrandom ^= xxrandom >> 7;
+        xxrandom ^= xxrandom << 17;
+        return 1 + static_cast<std::size_t>(xxrandom % (2 * xxsample_rate));
+    }
+
+private:
+    manager_type& xxmanager;
+    guarded_pool_t& xxpool;
+
+    std::size_t xxsample_rate = 0;
+    std::size_t xxcountdown = 0;
+    std::uint64_t xxrandom = 0;
+};
+
+} // namespace eightmory
+
+#endif // EIGHTMORY_GUARDED_HPP
@@ -0,0 +1,49 @@
+#ifndef EIGHTMORY_HOOKS_HPP
+#define EIGHTMORY_HOOKS_HPP
+
+#include <Eightmory/Core.hpp>
+
+#include <cstddef> // size_t
+#include <cstdint> // uint32_t
+
+namespace eightmory
+{
+
+// run-time hooks for external profilers, unset callbacks are skipped
+// callbacks are called after allocate and extend, and before free
+struct callback_hooks_t
+{
+    void* context = nullptr;
+
+    void (*on_allocate)(void* context, void* memory, std::size_t size, std::uint32_t tag) = nullptr;
+    void (*on_free)(void* context, void* memory, std::size_t size, std::uint32_t tag) = nullptr;
+    void (*on_extend)(void* context, void* memory, std::size_t size, std::uint32_t tag) = nullptr;
+    void (*on_coalesce)(void* context, void* memory, std::size_t size) = nullptr;
+
+public:
+    void allocate(void* memory, std::size_t size, std::uint32_t tag) noexcept
+    {
+        if (on_allocate != nullptr) on_allocate(context, memory, size, tag);
+    }
+
+    void free(void* memory, std::size_t size, std::uint32_t tag) noexcept
+    {
+        if (on_free != nullptr) on_free(context, memory, size, tag);
+    }
+
+    void extend(void* memory, std::size_t size, std::uint32_t tag) noexcept
+    {
+        if (on_extend != nullptr) on_extend(context, memory, size, tag);
+    }
+
+    void coalesce(void* memory, std::size_t size) noexcept
+    {
+        if (on_coalesce != nullptr) on_coalesce(context, memory, size);
+    }
+};
+
+using hooked_segment_manager_t = basic_segment_manager_t<first_fit_t, lazy_coalesce_t, segment_t, no_stats_t, callback_hooks_t>;
+
+} // namespace eightmory
+
+#endif // EIGHTMORY_HOOKS_HPP
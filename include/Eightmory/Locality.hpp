@@ -0,0 +1,130 @@
+#ifndef EIGHTMORY_LOCALITY_HPP
+#define EIGHTMORY_LOCALITY_HPP
+
+#include <Eightmory/Core.hpp>
+
+#include <cstddef> // size_t
+#include <cstdint> // uint32_t
+#include <array> // array
+
+namespace eightmory
+{
+
+// co-allocation of related segments, built on search from hint
+// segment near object is placed at first free place after it, members of group follow last member,
+// so related segments are walked in address order instead of jumping across heap
+// search from begin is fallback, if nothing fits after hint
+template <typename ManagerType>
+class basic_locality_segment_manager_t
+{
+public:
+    using manager_type = ManagerType;
+    using segment_type = typename ManagerType::segment_type;
+
+    static constexpr auto group_count = std::size_t(16);
+
+public:
+    basic_locality_segment_manager_t(void* memory, std::size_t bytes) noexcept : xxmanager(memory, bytes)
+    {
+        xxcursors.fill(nullptr);
+    }
+
+public:
+    [[nodiscard]] void* add_segment(std::size_t size) noexcept
+    {
+        return xxmanager.add_segment(size);
+    }
+
+    // allocate segment close after near, which must be used segment memory
+    // return 'pointer to segment memory'
+    [[nodiscard]] void* add_segment_near(std::size_t size, void* near) noexcept
+    {
+        if (near == nullptr)
+        {
+            return xxmanager.add_segment(size);
+        }
+        return add_segment_after(size, segment_type::segment(near), 0);
+    }
+
+    // allocate segment close after last allocated member of group
+    // group is stored as tag by tagged segment types
+    // return 'pointer to segment memory' or 'nullptr' if group is out of range
+    [[nodiscard]] void* add_segment_to_group(std::size_t size, std::size_t group) noexcept
+    {
+        if (group >= group_count)
+        {
+            return nullptr;
+        }
+
+        auto& cursor = xxcursors[group];
+        auto memory = add_segment_after(size, cursor != nullptr ? cursor : xxmanager.begin(), static_cast<std::uint32_t>(group));
+        if (memory != nullptr)
+        {
+            cursor = segment_type::segment(memory);
+        }
+        return memory;
+    }
+
+    bool extend_segment(void* memory) noexcept
+    {
+        return xxmanager.extend_segment(memory);
+    }
+
+    bool extend_segment(void* memory, std::size_t size) noexcept
+    {
+        return xxmanager.extend_segment(memory, size);
+    }
+
+    // removed segment may be merged later, so it cannot stay cursor of group
+    bool remove_segment(void* memory) noexcept
+    {
+        auto const segment = segment_type::segment(memory);
+        if constexpr (requires { segment->tag; })
+        {
+            auto const group = segment_tag(segment);
+            if (group < group_count && xxcursors[group] == segment)
+            {
+                xxcursors[group] = nullptr;
+            }
+        }
+        else
+        {
+            for (auto& cursor : xxcursors)
+            {
+                if (cursor == segment)
+                {
+                    cursor = nullptr;
+                }
+            }
+        }
+        return xxmanager.remove_segment(memory);
+    }
+
+public:
+    // return 'last allocated segment of group' or 'nullptr'
+    segment_type* cursor(std::size_t group) const noexcept { return group < group_count ? xxcursors[group] : nullptr; }
+
+    manager_type& manager() noexcept { return xxmanager; }
+    manager_type const& manager() const noexcept { return xxmanager; }
+
+private:
+    void* add_segment_after(std::size_t size, segment_type* hint, std::uint32_t tag) noexcept
+    {
+        auto memory = xxmanager.add_segment(size, hint, tag);
+        if (memory == nullptr && hint != xxmanager.begin())
+        {
+            memory = xxmanager.add_segment(size, xxmanager.begin(), tag);
+        }
+        return memory;
+    }
+
+private:
+    manager_type xxmanager;
+    std::array<segment_type*, group_count> xxcursors;
+};
+
+using locality_segment_manager_t = basic_locality_segment_manager_t<segment_manager_t>;
+
+} // namespace eightmory
+
+#endif // EIGHTMORY_LOCALITY_HPP
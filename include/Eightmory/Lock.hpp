@@ -0,0 +1,77 @@
+#ifndef EIGHTMORY_LOCK_HPP
+#define EIGHTMORY_LOCK_HPP
+
+#include <cstddef> // size_t
+#include <cstdint> // uint32_t
+#include <atomic> // atomic
+#include <thread> // yield
+
+namespace eightmory
+{
+
+// test and test-and-set lock, lock word holds id of owner or 0 if unlocked
+// lock is address free, so it may be stored in memory shared between processes
+class spin_lock_t
+{
+public:
+    static constexpr auto npos = std::size_t(-1);
+    static constexpr auto default_owner = std::uint32_t(1);
+
+    static_assert(std::atomic<std::uint32_t>::is_always_lock_free);
+
+public:
+    void lock(std::uint32_t owner = default_owner) noexcept
+    {
+        while (!try_lock(owner))
+        {
+            wait();
+        }
+    }
+
+    // return 'true' if locked
+    bool try_lock(std::uint32_t owner = default_owner) noexcept
+    {
+        auto expected = std::uint32_t(0);
+        return xxowner.compare_exchange_strong(expected, owner, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    void unlock() noexcept
+    {
+        xxowner.store(0, std::memory_order_release);
+    }
+
+    // wait without writing to cache line of lock, until it's unlocked or spin_count spins passed
+    // return 'true' if unlocked
+    bool wait(std::size_t spin_count = npos) const noexcept
+    {
+        for (std::size_t spin = 0; xxowner.load(std::memory_order_relaxed) != 0; ++spin)
+        {
+            if (spin == spin_count)
+            {
+                return false;
+            }
+            if (spin > 64)
+            {
+                std::this_thread::yield();
+            }
+        }
+        return true;
+    }
+
+    // pass lock of owner, which cannot unlock it anymore, to new owner
+    // return 'true' if taken over
+    bool take_over(std::uint32_t dead_owner, std::uint32_t owner) noexcept
+    {
+        return xxowner.compare_exchange_strong(dead_owner, owner, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    // return 'id of owner' or '0' if unlocked
+    std::uint32_t owner() const noexcept { return xxowner.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<std::uint32_t> xxowner{0};
+};
+
+} // namespace eightmory
+
+#endif // EIGHTMORY_LOCK_HPP
@@ -0,0 +1,44 @@
+#ifndef EIGHTMORY_MAPPING_HPP
+#define EIGHTMORY_MAPPING_HPP
+
+#include <cstddef> // size_t
+
+namespace eightmory
+{
+
+struct mapping_t
+{
+    void* memory = nullptr;
+    std::size_t bytes = 0;
+
+#ifdef _WIN32
+    void* file = nullptr;
+    void* handle = nullptr;
+#else
+    int file = -1;
+#endif // _WIN32
+};
+
+// map file with read/write access, shared between all mappings of file
+// if bytes is not 0, file will be created or truncated to given size
+// return 'true' if mapped
+EIGHTMORY_API bool map_file(mapping_t& mapping, char const* path, std::size_t bytes) noexcept;
+
+// map named shared memory with read/write access, visible to other processes
+// if bytes is not 0, shared memory will be created, existing one is an error
+// return 'true' if mapped
+EIGHTMORY_API bool map_shared(mapping_t& mapping, char const* name, std::size_t bytes) noexcept;
+
+// remove name of shared memory, existing mappings stay valid
+// return 'true' if removed
+EIGHTMORY_API bool unlink_shared(char const* name) noexcept;
+
+// write mapped pages to file
+// return 'true' if synced
+EIGHTMORY_API bool sync_mapping(mapping_t& mapping) noexcept;
+
+EIGHTMORY_API void unmap(mapping_t& mapping) noexcept;
+
+} // namespace eightmory
+
+#endif // EIGHTMORY_MAPPING_HPP
@@ -0,0 +1,170 @@
+#ifndef EIGHTMORY_NESTED_HPP
+#define EIGHTMORY_NESTED_HPP
+
+#include <Eightmory/Core.hpp>
+
+#include <cstddef> // size_t
+#include <cstdint> // uintptr_t
+#include <utility> // move
+
+namespace eightmory
+{
+
+// child heap inside single segment of parent manager
+// all child segments are released at once by one remove_segment on parent,
+// and child heap grows in place by extend_segment on parent
+template <typename ParentType, typename ManagerType = segment_manager_t>
+class nested_segment_manager_t
+{
+public:
+    using parent_type = ParentType;
+    using manager_type = ManagerType;
+    using segment_type = typename ManagerType::segment_type;
+
+public:
+    explicit nested_segment_manager_t(parent_type& parent) noexcept : xxparent(parent) {}
+    ~nested_segment_manager_t() { close(); }
+
+    nested_segment_manager_t(nested_segment_manager_t const&) = delete;
+    nested_segment_manager_t& operator=(nested_segment_manager_t const&) = delete;
+
+public:
+    // take segment of given bytes from parent, is_growable allows add_segment to extend it when full
+    // return 'true' if created
+    bool create(std::size_t bytes, bool is_growable = true) noexcept
+    {
+        close();
+
+        xxmemory = xxparent.add_segment(bytes);
+        if (xxmemory == nullptr)
+        {
+            return false;
+        }
+
+        rebuild();
+        if (xxmanager.begin() == nullptr)
+        {
+            close();
+            return false;
+        }
+
+        xxis_growable = is_growable;
+        return true;
+    }
+
+    // release all child segments with single remove_segment on parent
+    void close() noexcept
+    {
+        if (xxmemory != nullptr)
+        {
+            xxparent.remove_segment(xxmemory);
+            xxmemory = nullptr;
+        }
+        rebuild();
+    }
+
+    // release all child segments, but keep segment of parent
+    void reset() noexcept
+    {
+        if (xxmemory != nullptr)
+        {
+            rebuild();
+        }
+    }
+
+    // extend segment of parent by at least bytes, and append them to child heap
+    // return 'true' if grown
+    bool grow(std::size_t bytes) noexcept
+    {
+        if (xxmemory == nullptr || !xxparent.extend_segment(xxmemory, bytes))
+        {
+            return false;
+        }
+
+        // parent may grant up to its header size more, and less than child header may be left from last grow
+        auto const bytes_after = heap_bytes();
+        return bytes_after > xxmanager.bytes() && xxmanager.extend_heap(bytes_after - xxmanager.bytes());
+    }
+
+public:
+    // grows child heap twice, or at least by size, if it is full
+    [[nodiscard]] void* add_segment(std::size_t size) noexcept
+    {
+        auto memory = xxmanager.add_segment(size);
+        if (memory == nullptr && xxis_growable && xxmemory != nullptr)
+        {
+            auto const need = size + sizeof(segment_type);
+            if (grow(need > xxmanager.bytes() ? need : xxmanager.bytes()) || grow(need))
+            {
+                memory = xxmanager.add_segment(size);
+            }
+        }
+        return memory;
+    }
+
+    bool extend_segment(void* memory) noexcept
+    {
+        return xxmanager.extend_segment(memory);
+    }
+
+    bool extend_segment(void* memory, std::size_t size) noexcept
+    {
+        return xxmanager.extend_segment(memory, size);
+    }
+
+    bool remove_segment(void* memory) noexcept
+    {
+        return xxmanager.remove_segment(memory);
+    }
+
+public:
+    bool is_open() const noexcept { return xxmemory != nullptr; }
+
+    // return 'segment memory in parent', child heap starts there or up to child header alignment later
+    void* memory() const noexcept { return xxmemory; }
+    std::size_t bytes() const noexcept { return xxmanager.bytes(); }
+
+    manager_type& manager() noexcept { return xxmanager; }
+    manager_type const& manager() const noexcept { return xxmanager; }
+    parent_type& parent() const noexcept { return xxparent; }
+
+private:
+    // heap is created again, but hooks installed by user are kept
+    void rebuild() noexcept
+    {
+        auto hooks = std::move(xxmanager.hooks());
+        xxmanager = xxmemory != nullptr ? manager_type(heap_memory(), heap_bytes()) : manager_type(nullptr, 0);
+        xxmanager.hooks() = std::move(hooks);
+    }
+
+    // segment memory of parent is aligned for parent headers only,
+    // so child heap starts and ends at alignment of child headers
+    std::size_t heap_offset() const noexcept
+    {
+        auto const address = reinterpret_cast<std::uintptr_t>(xxmemory);
+        return static_cast<std::size_t>(align_up(address, alignof(segment_type)) - address);
+    }
+
+    void* heap_memory() const noexcept
+    {
+        return static_cast<char*>(xxmemory) + heap_offset();
+    }
+
+    std::size_t heap_bytes() const noexcept
+    {
+        auto const bytes = parent_type::segment_type::segment(xxmemory)->size;
+        auto const offset = heap_offset();
+        return bytes < offset ? 0 : ~(alignof(segment_type) - 1) & (bytes - offset);
+    }
+
+private:
+    parent_type& xxparent;
+    manager_type xxmanager{nullptr, 0};
+
+    void* xxmemory = nullptr;
+    bool xxis_growable = true;
+};
+
+} // namespace eightmory
+
+#endif // EIGHTMORY_NESTED_HPP
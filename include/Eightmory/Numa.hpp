@@ -0,0 +1,105 @@
+#ifndef EIGHTMORY_NUMA_HPP
+#define EIGHTMORY_NUMA_HPP
+
+#include <Eightmory/Core.hpp>
+#include <Eightmory/Lock.hpp>
+
+#include <cstddef> // size_t
+
+namespace eightmory
+{
+
+inline constexpr auto max_numa_nodes = std::size_t(64);
+
+// how memory of arena was placed on its node
+enum class numa_binding_t
+{
+    none,
+    bind,
+    first_touch,
+};
+
+// return 'number of NUMA nodes with memory', 1 if system has no NUMA or it is unknown
+EIGHTMORY_API std::size_t numa_node_count() noexcept;
+
+// return 'NUMA node of calling CPU', 0 if unknown
+EIGHTMORY_API std::size_t current_numa_node() noexcept;
+
+// one segment_manager_t per NUMA node over memory placed on that node
+// allocation goes to arena of calling CPU node, free goes to arena, which owns memory
+// each arena is serialized by own spin lock, so threads of different nodes do not contend
+// on system without NUMA there is single arena
+class EIGHTMORY_API numa_arenas_t
+{
+public:
+    static constexpr auto npos = std::size_t(-1);
+
+public:
+    numa_arenas_t() noexcept = default;
+    ~numa_arenas_t();
+
+    numa_arenas_t(numa_arenas_t const&) = delete;
+    numa_arenas_t& operator=(numa_arenas_t const&) = delete;
+
+public:
+    // map bytes_per_node for each node, bound to node with mbind,
+    // or first touched by calling thread moved to CPUs of node if binding is not permitted
+    // return 'true' if created
+    bool create(std::size_t bytes_per_node) noexcept;
+    void close() noexcept;
+
+public:
+    // allocate from arena of calling CPU node, other arenas are tried if it is full
+    [[nodiscard]] void* add_segment(std::size_t size) noexcept;
+
+    // allocate from arena of given index only
+    [[nodiscard]] void* add_segment(std::size_t size, std::size_t arena) noexcept;
+
+    bool extend_segment(void* memory) noexcept;
+    bool extend_segment(void* memory, std::size_t size) noexcept;
+
+    // cross-node memory is returned to owning arena
+    bool remove_segment(void* memory) noexcept;
+
+public:
+    // return 'index of arena', which owns memory, or 'npos'
+    std::size_t arena_of(void const* memory) const noexcept;
+
+    // return 'index of arena' of calling CPU node
+    std::size_t local_arena() const noexcept;
+
+    std::size_t arena_count() const noexcept { return xxarena_count; }
+
+    // return 'NUMA node' of arena
+    std::size_t node(std::size_t arena) const noexcept { return xxarenas[arena].node; }
+    numa_binding_t binding(std::size_t arena) const noexcept { return xxarenas[arena].binding; }
+
+    // direct access requires lock of arena
+    segment_manager_t& manager(std::size_t arena) noexcept { return xxarenas[arena].manager; }
+
+    void lock(std::size_t arena) noexcept;
+    void unlock(std::size_t arena) noexcept;
+
+private:
+    struct alignas(64) arena_t
+    {
+        spin_lock_t lock;
+        segment_manager_t manager{nullptr, 0};
+
+        char* memory = nullptr;
+        std::size_t bytes = 0;
+        std::size_t node = 0;
+        numa_binding_t binding = numa_binding_t::none;
+    };
+
+private:
+    arena_t xxarenas[max_numa_nodes];
+    std::size_t xxarena_count = 0;
+
+    // arena index of each node
+    std::size_t xxnode_arenas[max_numa_nodes] = {};
+};
+
+} // namespace eightmory
+
+#endif // EIGHTMORY_NUMA_HPP
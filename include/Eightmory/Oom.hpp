@@ -0,0 +1,138 @@
+#ifndef EIGHTMORY_OOM_HPP
+#define EIGHTMORY_OOM_HPP
+
+#include <Eightmory/Core.hpp>
+
+#include <cstddef> // size_t
+
+namespace eightmory
+{
+
+// called on allocation failure, which full coalesce pass has not fixed
+// callback may release segments of manager, size is requested size
+// return 'true' if memory was released and allocation should be retried
+using oom_reclaim_t = bool (*)(void* context, std::size_t size);
+
+// manager, which does not fail on fake out of memory:
+// free bytes split over runs of free segments, which search from hint starts in the middle of,
+// are merged by full coalesce pass before user reclaim callback is called, then allocation is retried once
+template <typename ManagerType>
+class basic_oom_segment_manager_t
+{
+public:
+    using manager_type = ManagerType;
+    using segment_type = typename ManagerType::segment_type;
+
+public:
+    basic_oom_segment_manager_t(void* memory, std::size_t bytes) noexcept : xxmanager(memory, bytes) {}
+
+    basic_oom_segment_manager_t(void* memory, std::size_t bytes, oom_reclaim_t reclaim, void* context) noexcept
+        : xxmanager(memory, bytes), xxreclaim(reclaim), xxcontext(context) {}
+
+public:
+    // unset callback leaves coalesce pass only
+    void set_reclaim(oom_reclaim_t reclaim, void* context) noexcept
+    {
+        xxreclaim = reclaim;
+        xxcontext = context;
+    }
+
+    [[nodiscard]] void* add_segment(std::size_t size) noexcept
+    {
+        return add_segment(size, xxmanager.begin());
+    }
+
+    [[nodiscard]] void* add_segment(std::size_t size, segment_type* hint) noexcept
+    {
+        auto memory = xxmanager.add_segment(size, hint);
+        if (memory != nullptr)
+        {
+            return memory;
+        }
+
+        ++xxcoalesce_count;
+        if (xxmanager.coalesce() < size && !reclaim(size))
+        {
+            ++xxfailure_count;
+            return nullptr;
+        }
+
+        // hint may be merged into lhs segment, so retry searches from begin
+        memory = xxmanager.add_segment(size);
+        if (memory == nullptr)
+        {
+            ++xxfailure_count;
+            return nullptr;
+        }
+
+        ++xxrecovered_count;
+        return memory;
+    }
+
+    bool extend_segment(void* memory) noexcept
+    {
+        return xxmanager.extend_segment(memory);
+    }
+
+    // rhs run is merged by extend itself, so only reclaim callback may help
+    bool extend_segment(void* memory, std::size_t size) noexcept
+    {
+        if (xxmanager.extend_segment(memory, size))
+        {
+            return true;
+        }
+
+        if (!reclaim(size) || !xxmanager.extend_segment(memory, size))
+        {
+            ++xxfailure_count;
+            return false;
+        }
+
+        ++xxrecovered_count;
+        return true;
+    }
+
+    bool remove_segment(void* memory) noexcept
+    {
+        return xxmanager.remove_segment(memory);
+    }
+
+public:
+    // number of full coalesce passes, callback calls, allocations saved by them and real failures
+    std::size_t coalesce_count() const noexcept { return xxcoalesce_count; }
+    std::size_t reclaim_count() const noexcept { return xxreclaim_count; }
+    std::size_t recovered_count() const noexcept { return xxrecovered_count; }
+    std::size_t failure_count() const noexcept { return xxfailure_count; }
+
+    manager_type& manager() noexcept { return xxmanager; }
+    manager_type const& manager() const noexcept { return xxmanager; }
+
+private:
+    bool reclaim(std::size_t size) noexcept
+    {
+        if (xxreclaim == nullptr)
+        {
+            return false;
+        }
+
+        ++xxreclaim_count;
+        return xxreclaim(xxcontext, size);
+    }
+
+private:
+    manager_type xxmanager;
+
+    oom_reclaim_t xxreclaim = nullptr;
+    void* xxcontext = nullptr;
+
+    std::size_t xxcoalesce_count = 0;
+    std::size_t xxreclaim_count = 0;
+    std::size_t xxrecovered_count = 0;
+    std::size_t xxfailure_count = 0;
+};
+
+using oom_segment_manager_t = basic_oom_segment_manager_t<segment_manager_t>;
+
+} // namespace eightmory
+
+#endif // EIGHTMORY_OOM_HPP
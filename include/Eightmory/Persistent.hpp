@@ -0,0 +1,82 @@
+#ifndef EIGHTMORY_PERSISTENT_HPP
+#define EIGHTMORY_PERSISTENT_HPP
+
+#include <Eightmory/Core.hpp>
+#include <Eightmory/Mapping.hpp>
+
+#include <cstddef> // size_t
+#include <cstdint> // uint64_t, uint32_t
+
+namespace eightmory
+{
+
+// stored at begin of file, segments follow it
+struct persistent_header_t
+{
+    std::uint64_t magic;
+    std::uint32_t version;
+    std::uint32_t segment_bytes;
+    std::uint64_t bytes;
+    std::uint64_t root;
+    std::uint64_t reserved[4];
+
+    static constexpr std::uint64_t signature = 0x59524F4D54484745; // "EGHTMORY"
+    static constexpr std::uint32_t current_version = 1;
+};
+
+class EIGHTMORY_API persistent_segment_manager_t
+{
+public:
+    static constexpr auto npos = std::size_t(-1);
+
+public:
+    persistent_segment_manager_t() noexcept = default;
+    ~persistent_segment_manager_t();
+
+    persistent_segment_manager_t(persistent_segment_manager_t const&) = delete;
+    persistent_segment_manager_t& operator=(persistent_segment_manager_t const&) = delete;
+
+public:
+    // create file with heap of given bytes, existing file will be overridden
+    // return 'true' if created
+    bool create(char const* path, std::size_t bytes) noexcept;
+
+    // map existing file at any address, validate and recover segments
+    // return 'true' if opened
+    bool open(char const* path) noexcept;
+
+    // write heap to file
+    // return 'true' if flushed
+    bool flush() noexcept;
+
+    // flush and unmap file
+    void close() noexcept;
+
+public:
+    // return 'offset from heap begin' or 'npos' for nullptr
+    std::size_t offset(void const* memory) const noexcept;
+
+    // return 'pointer to memory' or 'nullptr' for npos
+    void* memory(std::size_t offset) const noexcept;
+
+    // store entry point of persistent data
+    void root(void* memory) noexcept;
+    void* root() const noexcept;
+
+public:
+    segment_manager_t& manager() noexcept { return xxmanager; }
+    bool is_open() const noexcept { return xxheader != nullptr; }
+
+    // return 'true' if broken segments were cut off on last open
+    bool is_recovered() const noexcept { return xxrecovered; }
+
+private:
+    mapping_t xxmapping;
+    segment_manager_t xxmanager = segment_manager_t(nullptr, 0);
+    persistent_header_t* xxheader = nullptr;
+    bool xxrecovered = false;
+};
+
+} // namespace eightmory
+
+#endif // EIGHTMORY_PERSISTENT_HPP
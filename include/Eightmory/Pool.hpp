@@ -0,0 +1,123 @@
+#ifndef EIGHTMORY_POOL_HPP
+#define EIGHTMORY_POOL_HPP
+
+#include <cstddef> // size_t
+#include <cstdint> // uint64_t, uint32_t
+#include <atomic> // atomic
+
+namespace eightmory
+{
+
+// lock-free pool of fixed size blocks in memory of single segment
+// free list is Treiber stack of chains of blocks, its head is block index with version tag against ABA
+// free block stores [next block in chain : 4] [next chain : 4]
+class EIGHTMORY_API fixed_pool_t
+{
+public:
+    static constexpr auto npos = std::uint32_t(-1);
+    static constexpr auto block_align = std::size_t(8);
+
+public:
+    // block_size is aligned up to 8, blocks are pushed in chains of batch_size
+    fixed_pool_t(void* memory, std::size_t bytes, std::size_t block_size, std::size_t batch_size = 32) noexcept;
+
+    fixed_pool_t(fixed_pool_t const&) = delete;
+    fixed_pool_t& operator=(fixed_pool_t const&) = delete;
+
+public:
+    // return 'bytes of segment' for block_count blocks, with alignment slack
+    static constexpr std::size_t bytes_for(std::size_t block_size, std::size_t block_count) noexcept
+    {
+        return ((block_size + block_align - 1) & ~(block_align - 1)) * block_count + block_align - 1;
+    }
+
+    // thread-safe, pops chain and pushes its rest back, so it costs two exchanges of shared head
+    // single block cannot be popped alone, since other thread may own the chain meanwhile
+    // hot paths should allocate through fixed_pool_cache_t
+    // return 'pointer to block' or 'nullptr' if pool is empty
+    [[nodiscard]] void* allocate() noexcept;
+
+    // thread-safe
+    void deallocate(void* memory) noexcept;
+
+    // pop whole chain of free blocks
+    // return 'index of first block' or 'npos' if pool is empty
+    std::uint32_t pop_chain() noexcept;
+
+    // push chain of free blocks linked by next block, ended by npos
+    void push_chain(std::uint32_t first) noexcept;
+
+public:
+    std::uint32_t index(void const* memory) const noexcept
+    {
+        return static_cast<std::uint32_t>((static_cast<char const*>(memory) - xxblocks) / xxblock_size);
+    }
+
+    void* block(std::uint32_t index) const noexcept { return xxblocks + std::size_t(index) * xxblock_size; }
+
+    // next block in chain, accessed by owner of chain only
+    std::uint32_t& next_block(std::uint32_t index) const noexcept { return *reinterpret_cast<std::uint32_t*>(block(index)); }
+
+    bool contains(void const* memory) const noexcept
+    {
+        auto const address = static_cast<char const*>(memory);
+        return address >= xxblocks && address < xxblocks + xxblock_count * xxblock_size;
+    }
+
+    std::size_t block_size() const noexcept { return xxblock_size; }
+    std::size_t block_count() const noexcept { return xxblock_count; }
+    std::size_t batch_size() const noexcept { return xxbatch_size; }
+
+private:
+    // next chain of chain head, read concurrently by poppers
+    std::atomic_ref<std::uint32_t> next_chain(std::uint32_t index) const noexcept
+    {
+        return std::atomic_ref<std::uint32_t>(reinterpret_cast<std::uint32_t*>(block(index))[1]);
+    }
+
+private:
+    char* xxblocks = nullptr;
+    std::size_t xxblock_size = 0;
+    std::size_t xxblock_count = 0;
+    std::size_t xxbatch_size = 0;
+
+    // [tag : 32] [index : 32]
+    alignas(64) std::atomic<std::uint64_t> xxhead{npos};
+};
+
+// per-thread cache of blocks, shares pool by chains of batch_size blocks
+// so most of allocations and deallocations do not touch shared head
+// not thread-safe, each thread must use own cache
+class EIGHTMORY_API fixed_pool_cache_t
+{
+public:
+    explicit fixed_pool_cache_t(fixed_pool_t& pool) noexcept : xxpool(pool) {}
+    ~fixed_pool_cache_t();
+
+    fixed_pool_cache_t(fixed_pool_cache_t const&) = delete;
+    fixed_pool_cache_t& operator=(fixed_pool_cache_t const&) = delete;
+
+public:
+    // return 'pointer to block' or 'nullptr' if pool and cache are empty
+    [[nodiscard]] void* allocate() noexcept;
+    void deallocate(void* memory) noexcept;
+
+    // return all cached blocks to pool
+    void flush() noexcept;
+
+    std::size_t count() const noexcept { return xxcount; }
+
+private:
+    // keep batch_size blocks from top of cache, push older blocks below them to pool
+    void release_batch() noexcept;
+
+private:
+    fixed_pool_t& xxpool;
+
+    std::uint32_t xxfirst = fixed_pool_t::npos;
+    std::size_t xxcount = 0;
+};
+
+} // namespace eightmory
+
+#endif // EIGHTMORY_POOL_HPP
@@ -0,0 +1,132 @@
+#ifndef EIGHTMORY_PROFILER_HPP
+#define EIGHTMORY_PROFILER_HPP
+
+#include <Eightmory/Core.hpp>
+
+#include <cstddef> // size_t
+#include <cstdint> // uint64_t, uint32_t
+#include <cstdio> // FILE
+#include <unordered_map> // unordered_map
+#include <vector> // vector
+
+namespace eightmory
+{
+
+// sampling heap profiler, used as hooks policy
+// stack is captured once per sample_period allocated bytes in average, using geometric distribution
+// so allocations are sampled with probability proportional to its size, and cost of fast path is single subtraction
+// not thread-safe, as segment managers are
+class EIGHTMORY_API heap_profiler_t
+{
+public:
+    static constexpr auto npos = std::size_t(-1);
+    static constexpr auto default_sample_period = std::size_t(512 * 1024);
+    static constexpr auto max_depth = std::size_t(32);
+    static constexpr auto filter_size = std::size_t(1024);
+
+    struct bucket_t
+    {
+        std::uint64_t hash = 0;
+        std::size_t depth = 0;
+        void* frames[max_depth] = {};
+
+        // live heap
+        std::size_t inuse_count = 0;
+        std::size_t inuse_bytes = 0;
+
+        // cumulative allocations
+        std::size_t alloc_count = 0;
+        std::size_t alloc_bytes = 0;
+    };
+
+public:
+    explicit heap_profiler_t(std::size_t sample_period = default_sample_period, std::uint64_t seed = 0x8E16) noexcept;
+
+public:
+    void allocate(void* memory, std::size_t size, std::uint32_t tag) noexcept
+    {
+        if (size < xxbytes_until_sample)
+        {
+            xxbytes_until_sample -= size;
+            return;
+        }
+        sample(memory, size, tag);
+    }
+
+    void free(void* memory, std::size_t, std::uint32_t) noexcept
+    {
+        if (xxfilter[filter_index(memory)] != 0)
+        {
+            release(memory);
+        }
+    }
+
+    void extend(void* memory, std::size_t size, std::uint32_t) noexcept
+    {
+        if (xxfilter[filter_index(memory)] != 0)
+        {
+            resize(memory, size);
+        }
+    }
+
+    void coalesce(void*, std::size_t) noexcept {}
+
+public:
+    // 0 disables sampling
+    void set_sample_period(std::size_t sample_period) noexcept;
+    std::size_t sample_period() const noexcept { return xxsample_period; }
+
+    std::vector<bucket_t> const& buckets() const noexcept { return xxbuckets; }
+    std::size_t live_samples() const noexcept { return xxsamples.size(); }
+
+    // drop all samples and stacks
+    void reset() noexcept;
+
+    // write live heap and cumulative allocations in legacy gperftools heap profile format, readable by pprof
+    // counts are not scaled, heap_v2 header lets pprof unsample them by sample period
+    // return 'true' if written
+    bool write_heap_profile(std::FILE* file) const noexcept;
+    bool write_heap_profile(char const* path) const noexcept;
+
+private:
+    struct sample_t
+    {
+        std::size_t bucket = 0;
+        std::size_t size = 0;
+    };
+
+private:
+    void sample(void* memory, std::size_t size, std::uint32_t tag) noexcept;
+    void release(void* memory) noexcept;
+    void resize(void* memory, std::size_t size) noexcept;
+
+    // return 'bytes to next sample', exponentially distributed with mean of sample_period
+    std::size_t next_sample_distance() noexcept;
+
+    // return 'bucket index' or 'npos' if bucket cannot be added
+    std::size_t find_bucket(void* const* frames, std::size_t depth) noexcept;
+
+    static std::size_t filter_index(void* memory) noexcept
+    {
+        auto const address = reinterpret_cast<std::uintptr_t>(memory);
+        return ((address >> 4) ^ (address >> 14)) & (filter_size - 1);
+    }
+
+private:
+    std::size_t xxsample_period = 0;
+    std::size_t xxbytes_until_sample = 0;
+    std::uint64_t xxrandom = 0;
+
+    // count of live samples per filter_index, most of free calls stop here
+    std::uint32_t xxfilter[filter_size] = {};
+
+    std::vector<bucket_t> xxbuckets;
+    std::unordered_map<std::uint64_t, std::size_t> xxbucket_index;
+    std::unordered_map<void*, sample_t> xxsamples;
+};
+
+using profiled_segment_manager_t = basic_segment_manager_t<first_fit_t, lazy_coalesce_t, segment_t, no_stats_t, heap_profiler_t>;
+
+} // namespace eightmory
+
+#endif // EIGHTMORY_PROFILER_HPP
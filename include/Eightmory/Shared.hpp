@@ -0,0 +1,101 @@
+#ifndef EIGHTMORY_SHARED_HPP
+#define EIGHTMORY_SHARED_HPP
+
+#include <Eightmory/Core.hpp>
+#include <Eightmory/Mapping.hpp>
+#include <Eightmory/Lock.hpp>
+
+#include <cstddef> // size_t
+#include <cstdint> // uint64_t, uint32_t
+#include <atomic> // atomic
+
+namespace eightmory
+{
+
+// stored at begin of shared memory, segments follow it
+struct shared_header_t
+{
+    std::atomic<std::uint64_t> magic;
+    std::uint32_t version;
+    std::uint32_t segment_bytes;
+    std::uint64_t bytes;
+    // owner of lock is id of process
+    spin_lock_t lock;
+    std::atomic<std::uint32_t> dead_owner_count;
+    std::uint32_t reserved[8];
+
+    static constexpr std::uint64_t signature = 0x444552414853384D; // "M8SHARED"
+    static constexpr std::uint32_t current_version = 2;
+
+    // lock is shared between processes, so it must be address free
+    static_assert(sizeof(spin_lock_t) == sizeof(std::uint32_t));
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free);
+};
+
+// all operations are serialized with spin lock stored in shared memory
+// lock stores id of owner process, so lock of died process is taken over by waiter
+// pointers are process specific, use offsets to exchange them
+// headers are changed by other processes, so debug validation of pointers is reduced to range checks
+class EIGHTMORY_API shared_segment_manager_t
+{
+public:
+    static constexpr auto npos = std::size_t(-1);
+
+public:
+    shared_segment_manager_t() noexcept = default;
+    ~shared_segment_manager_t();
+
+    shared_segment_manager_t(shared_segment_manager_t const&) = delete;
+    shared_segment_manager_t& operator=(shared_segment_manager_t const&) = delete;
+
+public:
+    // create named shared memory with heap of given bytes
+    // return 'true' if created
+    bool create(char const* name, std::size_t bytes) noexcept;
+
+    // map shared memory created by other process
+    // return 'true' if opened
+    bool open(char const* name) noexcept;
+
+    // unmap shared memory, memory is released after all processes close it and name is removed
+    void close() noexcept;
+
+    // remove name of shared memory, should be called once by owner
+    // return 'true' if removed
+    static bool remove(char const* name) noexcept;
+
+public:
+    // same as segment_manager_t, but synchronized
+    [[nodiscard]] void* add_segment(std::size_t size) noexcept;
+    bool extend_segment(void* memory) noexcept;
+    bool extend_segment(void* memory, std::size_t size) noexcept;
+    bool remove_segment(void* memory) noexcept;
+
+public:
+    // return 'offset from heap begin' or 'npos' for nullptr
+    std::size_t offset(void const* memory) const noexcept;
+
+    // return 'pointer to memory' or 'nullptr' for npos
+    void* memory(std::size_t offset) const noexcept;
+
+public:
+    // manual synchronization for direct manager access
+    void lock() noexcept;
+    void unlock() noexcept;
+
+    // return 'count of locks taken over from died processes'
+    // died process may leave heap inconsistent, if it was interrupted in the middle of operation
+    std::uint32_t dead_owner_count() const noexcept;
+
+    segment_manager_t& manager() noexcept { return xxmanager; }
+    bool is_open() const noexcept { return xxheader != nullptr; }
+
+private:
+    mapping_t xxmapping;
+    segment_manager_t xxmanager = segment_manager_t(nullptr, 0);
+    shared_header_t* xxheader = nullptr;
+};
+
+} // namespace eightmory
+
+#endif // EIGHTMORY_SHARED_HPP
@@ -0,0 +1,211 @@
+#ifndef EIGHTMORY_STATIC_HPP
+#define EIGHTMORY_STATIC_HPP
+
+#include <Eightmory/Core.hpp>
+
+#include <cstddef> // size_t
+#include <climits> // CHAR_BIT
+#include <array> // array
+#include <bit> // endian
+
+namespace eightmory
+{
+
+// constexpr variant of segment_manager_t over own storage
+// segments are addressed by offsets of segment memory, so no reinterpret_cast is required
+// storage has same layout as segment_manager_t memory and can be attached to it at run-time
+template <std::size_t Bytes>
+class static_segment_manager_t
+{
+public:
+    static constexpr auto npos = std::size_t(-1);
+
+    static_assert(Bytes >= sizeof(segment_t) && Bytes <= segment_t::max_size, "Invalid static segment manager size.");
+    // order of bit-fields of segment_t is implementation defined and is reversed by big endian ABIs,
+    // so layout below matches it on little endian targets only
+    static_assert(std::endian::native == std::endian::little, "Only little endian layout of segment_t is supported.");
+
+public:
+    constexpr static_segment_manager_t() noexcept
+    {
+        write_segment(0, Bytes - sizeof(segment_t), false);
+    }
+
+public:
+    // same as segment_manager_t::add_segment
+    // return 'offset of segment memory' or 'npos'
+    constexpr std::size_t add_segment(std::size_t size) noexcept;
+
+    // same as segment_manager_t::extend_segment
+    constexpr bool extend_segment(std::size_t offset) noexcept;
+    constexpr bool extend_segment(std::size_t offset, std::size_t size) noexcept;
+
+    // same as segment_manager_t::remove_segment
+    constexpr bool remove_segment(std::size_t offset) noexcept;
+
+public:
+    constexpr std::size_t segment_size(std::size_t offset) const noexcept { return read_size(offset - sizeof(segment_t)); }
+    constexpr bool segment_is_used(std::size_t offset) const noexcept { return read_is_used(offset - sizeof(segment_t)); }
+
+    // return 'offset of segment memory' of first segment
+    constexpr std::size_t begin() const noexcept { return sizeof(segment_t); }
+
+    // return 'offset of next segment memory' or 'npos'
+    constexpr std::size_t next(std::size_t offset) const noexcept
+    {
+        auto const header = offset + read_size(offset - sizeof(segment_t));
+        return header == Bytes ? npos : header + sizeof(segment_t);
+    }
+
+    constexpr std::size_t bytes() const noexcept { return Bytes; }
+
+public:
+    void* memory(std::size_t offset) noexcept { return offset == npos ? nullptr : xxstorage.data() + offset; }
+
+    // run-time manager over same storage with all compile-time segments
+    segment_manager_t manager() noexcept { return segment_manager_t::attach(xxstorage.data(), Bytes); }
+
+private:
+    static constexpr auto used_shift = sizeof(std::size_t) * CHAR_BIT - 1;
+
+    constexpr std::size_t read_word(std::size_t header) const noexcept
+    {
+        auto word = std::size_t(0);
+        for (std::size_t index = sizeof(std::size_t); index-- > 0;)
+        {
+            word = (word << CHAR_BIT) | xxstorage[header + index];
+        }
+        return word;
+    }
+
+    constexpr std::size_t read_size(std::size_t header) const noexcept { return read_word(header) & segment_t::max_size; }
+    constexpr bool read_is_used(std::size_t header) const noexcept { return (read_word(header) >> used_shift) != 0; }
+
+    // same bits order as segment_t: size in low bits, is_used in high bit, low byte first
+    constexpr void write_segment(std::size_t header, std::size_t size, bool is_used) noexcept
+    {
+        auto word = size | (std::size_t(is_used) << used_shift);
+        for (std::size_t index = 0; index < sizeof(std::size_t); ++index)
+        {
+            xxstorage[header + index] = static_cast<unsigned char>(word);
+            word >>= CHAR_BIT;
+        }
+    }
+
+    // return 'true' if free rhs segment was merged
+    constexpr bool extend_segment_with_rhs(std::size_t header) noexcept
+    {
+        auto const rhs = header + sizeof(segment_t) + read_size(header);
+        if (rhs == Bytes || read_is_used(rhs))
+        {
+            return false;
+        }
+
+        write_segment(header, read_size(header) + sizeof(segment_t) + read_size(rhs), read_is_used(header));
+        return true;
+    }
+
+private:
+    alignas(segment_t) std::array<unsigned char, Bytes> xxstorage{};
+};
+
+template <std::size_t Bytes>
+constexpr std::size_t static_segment_manager_t<Bytes>::add_segment(std::size_t size) noexcept
+{
+    for (std::size_t header = 0; header != Bytes; header += sizeof(segment_t) + read_size(header))
+    {
+        if (read_is_used(header))
+        {
+            continue;
+        }
+
+        // lazy defragmentation
+        while
+        (
+            read_size(header) < size && extend_segment_with_rhs(header)
+        );
+
+        auto const segment_size = read_size(header);
+        if (segment_size >= sizeof(segment_t) + size)
+        {
+            write_segment(header, size, true);
+            write_segment(header + sizeof(segment_t) + size, segment_size - size - sizeof(segment_t), false);
+        }
+        else if (segment_size >= size)
+        {
+            write_segment(header, segment_size, true);
+        }
+        else
+        {
+            continue;
+        }
+
+        return header + sizeof(segment_t);
+    }
+    return npos;
+}
+
+template <std::size_t Bytes>
+constexpr bool static_segment_manager_t<Bytes>::extend_segment(std::size_t offset) noexcept
+{
+    auto const header = offset - sizeof(segment_t);
+    auto const prev_size = read_size(header);
+
+    while
+    (
+        extend_segment_with_rhs(header)
+    );
+
+    return read_size(header) > prev_size;
+}
+
+template <std::size_t Bytes>
+constexpr bool static_segment_manager_t<Bytes>::extend_segment(std::size_t offset, std::size_t size) noexcept
+{
+    auto const header = offset - sizeof(segment_t);
+    auto const rhs = offset + read_size(header);
+
+    if (rhs == Bytes || read_is_used(rhs))
+    {
+        return false;
+    }
+
+    while
+    (
+        read_size(rhs) < size && extend_segment_with_rhs(rhs)
+    );
+
+    auto const rhs_size = read_size(rhs);
+    if (rhs_size >= size)
+    {
+        write_segment(header, read_size(header) + size, true);
+        write_segment(rhs + size, rhs_size - size, false);
+        return true;
+    }
+    else if (sizeof(segment_t) + rhs_size >= size)
+    {
+        write_segment(header, read_size(header) + sizeof(segment_t) + rhs_size, true);
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+template <std::size_t Bytes>
+constexpr bool static_segment_manager_t<Bytes>::remove_segment(std::size_t offset) noexcept
+{
+    if (offset < sizeof(segment_t) || offset > Bytes)
+    {
+        return false;
+    }
+
+    auto const header = offset - sizeof(segment_t);
+    write_segment(header, read_size(header), false);
+    return true;
+}
+
+} // namespace eightmory
+
+#endif // EIGHTMORY_STATIC_HPP
@@ -0,0 +1,281 @@
+#ifndef EIGHTMORY_STATS_HPP
+#define EIGHTMORY_STATS_HPP
+
+#include <Eightmory/Core.hpp>
+
+#include <cstddef> // size_t
+#include <climits> // CHAR_BIT
+#include <array> // array
+#include <bit> // bit_width
+
+namespace eightmory
+{
+
+// allocator counters, updated in O(1) on each manager operation
+// free sizes are counted per segment, free rhs segments are merged lazily
+// largest free size falls back to bin bound when last segment of that size is used,
+// so fragmentation is estimate until snapshot of manager makes it exact by full walk
+struct segment_stats_t
+{
+    // free segments of size in range [2^(bin - 1), 2^bin), bin 0 is for empty segments
+    static constexpr auto bin_count = sizeof(std::size_t) * CHAR_BIT + 1;
+
+    std::size_t used_bytes = 0;
+    std::size_t free_bytes = 0;
+    std::size_t used_segments = 0;
+    std::size_t free_segments = 0;
+
+    std::array<std::size_t, bin_count> free_histogram{};
+
+    // upper bound of largest free segment size, exact if is_largest_free_exact
+    // largest free segment size is bounded by histogram, when last segment of that size is used or shrunk
+    std::size_t largest_free = 0;
+    bool is_largest_free_exact = true;
+
+    // free segments of largest free size, valid if is_largest_free_exact
+    std::size_t largest_free_count = 0;
+
+    std::size_t add_count = 0;
+    std::size_t failure_count = 0;
+    std::size_t split_count = 0;
+    std::size_t merge_count = 0;
+
+    // segments visited by add_segment searches
+    std::size_t visit_count = 0;
+    std::size_t last_visit_count = 0;
+    std::size_t max_visit_count = 0;
+
+public:
+    static constexpr std::size_t bin(std::size_t size) noexcept
+    {
+        return static_cast<std::size_t>(std::bit_width(size));
+    }
+
+    // return 'max size of free segments' in bin
+    static constexpr std::size_t bin_max_size(std::size_t bin) noexcept
+    {
+        return bin == 0 ? 0 : std::size_t(-1) >> (bin_count - 1 - bin);
+    }
+
+    // 0 if all free bytes are in single segment, up to 1 if free bytes are scattered
+    // O(1) estimate, value is lower bound while largest free segment size is not exact
+    // snapshot of manager refreshes it to exact value
+    double fragmentation() const noexcept
+    {
+        if (free_bytes == 0)
+        {
+            return 0.0;
+        }
+
+        auto const largest = largest_free < free_bytes ? largest_free : free_bytes;
+        return 1.0 - static_cast<double>(largest) / static_cast<double>(free_bytes);
+    }
+
+public:
+    template <typename SegmentType>
+    void init(SegmentType* begin, SegmentType* end) noexcept
+    {
+        *this = segment_stats_t{};
+        for (auto segment = begin; segment != end; segment = segment->next())
+        {
+            if (segment->is_used)
+            {
+                used_bytes += segment->size;
+                used_segments += 1;
+            }
+            else
+            {
+                free_bytes += segment->size;
+                free_segments += 1;
+                insert_free(segment->size);
+            }
+        }
+    }
+
+    // make largest free segment size exact by full walk, if required
+    template <typename SegmentType>
+    void refresh(SegmentType* begin, SegmentType* end) noexcept
+    {
+        if (is_largest_free_exact)
+        {
+            return;
+        }
+
+        largest_free = 0;
+        largest_free_count = 0;
+        for (auto segment = begin; segment != end; segment = segment->next())
+        {
+            if (segment->is_used)
+            {
+                continue;
+            }
+
+            if (segment->size > largest_free)
+            {
+                largest_free = segment->size;
+                largest_free_count = 0;
+            }
+            largest_free_count += segment->size == largest_free;
+        }
+        is_largest_free_exact = true;
+    }
+
+    void search() noexcept
+    {
+        add_count += 1;
+        last_visit_count = 0;
+    }
+
+    void visit() noexcept
+    {
+        visit_count += 1;
+        last_visit_count += 1;
+    }
+
+    void fail() noexcept
+    {
+        failure_count += 1;
+        update_max_visit_count();
+    }
+
+    // free segment was marked as used
+    template <typename SegmentType>
+    void add(SegmentType* segment) noexcept
+    {
+        free_bytes -= segment->size;
+        free_segments -= 1;
+        used_bytes += segment->size;
+        used_segments += 1;
+
+        erase_free(segment->size);
+        update_max_visit_count();
+    }
+
+    // free segment was split to segment and created free segment
+    template <typename SegmentType>
+    void split(SegmentType* segment, SegmentType* created) noexcept
+    {
+        free_bytes -= sizeof(SegmentType);
+        free_segments += 1;
+        split_count += 1;
+
+        erase_free(segment->size + sizeof(SegmentType) + created->size);
+        insert_free(segment->size);
+        insert_free(created->size);
+    }
+
+    // free rhs segment was merged to segment
+    template <typename SegmentType>
+    void merge(SegmentType* segment, std::size_t rhs_size) noexcept
+    {
+        free_segments -= 1;
+        merge_count += 1;
+
+        erase_free(rhs_size);
+        if (segment->is_used)
+        {
+            free_bytes -= rhs_size;
+            used_bytes += sizeof(SegmentType) + rhs_size;
+        }
+        else
+        {
+            free_bytes += sizeof(SegmentType);
+
+            erase_free(segment->size - sizeof(SegmentType) - rhs_size);
+            insert_free(segment->size);
+        }
+    }
+
+    // size bytes were moved from free rhs segment to segment, rhs became created
+    template <typename SegmentType>
+    void move(SegmentType*, SegmentType* created, std::size_t size) noexcept
+    {
+        free_bytes -= size;
+        used_bytes += size;
+
+        erase_free(created->size + size);
+        insert_free(created->size);
+    }
+
+    // used segment was marked as free
+    template <typename SegmentType>
+    void remove(SegmentType* segment) noexcept
+    {
+        used_bytes -= segment->size;
+        used_segments -= 1;
+        free_bytes += segment->size;
+        free_segments += 1;
+
+        insert_free(segment->size);
+    }
+
+    // free segment was appended to end of heap, lifetime counters are kept
+    template <typename SegmentType>
+    void append(SegmentType* segment) noexcept
+    {
+        free_bytes += segment->size;
+        free_segments += 1;
+
+        insert_free(segment->size);
+    }
+
+private:
+    void insert_free(std::size_t size) noexcept
+    {
+        free_histogram[bin(size)] += 1;
+
+        // bound is not less than any other free segment size
+        if (size > largest_free)
+        {
+            largest_free = size;
+            largest_free_count = 1;
+            is_largest_free_exact = true;
+        }
+        else if (size == largest_free && is_largest_free_exact)
+        {
+            largest_free_count += 1;
+        }
+    }
+
+    void erase_free(std::size_t size) noexcept
+    {
+        free_histogram[bin(size)] -= 1;
+        if (size != largest_free)
+        {
+            return;
+        }
+
+        // other segment of same size is still largest one
+        if (is_largest_free_exact && largest_free_count > 1)
+        {
+            largest_free_count -= 1;
+            return;
+        }
+
+        // next largest size is unknown, so only bound is known
+        // bins 0 and 1 hold single size each, so they are exact
+        auto top = bin_count;
+        while (top > 0 && free_histogram[top - 1] == 0)
+        {
+            --top;
+        }
+
+        largest_free = top == 0 ? 0 : bin_max_size(top - 1);
+        largest_free_count = top == 0 ? 0 : free_histogram[top - 1];
+        is_largest_free_exact = top <= 2;
+    }
+
+    void update_max_visit_count() noexcept
+    {
+        if (last_visit_count > max_visit_count)
+        {
+            max_visit_count = last_visit_count;
+        }
+    }
+};
+
+using stats_segment_manager_t = basic_segment_manager_t<first_fit_t, lazy_coalesce_t, segment_t, segment_stats_t>;
+
+} // namespace eightmory
+
+#endif // EIGHTMORY_STATS_HPP
@@ -0,0 +1,74 @@
+#ifndef EIGHTMORY_TABLE_HPP
+#define EIGHTMORY_TABLE_HPP
+
+#include <cstddef> // size_t
+#include <climits> // CHAR_BIT
+
+namespace eightmory
+{
+
+// segment metadata stored outside of managed memory
+struct segment_entry_t
+{
+    std::size_t offset;
+    std::size_t size : sizeof(std::size_t) * CHAR_BIT - 1;
+    std::size_t is_used : 1;
+};
+
+// entries are sorted by offset, cover whole memory and free entries are never adjacent
+// entries table is scanned instead of managed memory, and user writes cannot damage it
+class EIGHTMORY_API table_segment_manager_t
+{
+public:
+    table_segment_manager_t(void* memory, std::size_t bytes, segment_entry_t* entries, std::size_t capacity) noexcept;
+
+public:
+    // allocate segment of given size, memory is aligned exactly to align
+    // zero size is allocated as one byte, so each segment has own address
+    // align must be power of two
+    // return 'pointer to segment memory'
+    [[nodiscard]] void* add_segment(std::size_t size, std::size_t align = 1) noexcept;
+
+    // extend segment using all available free rhs memory
+    // return 'true' if extended
+    bool extend_segment(void* memory) noexcept;
+
+    // extend segment of given extra size
+    // return 'true' if extended
+    bool extend_segment(void* memory, std::size_t size) noexcept;
+
+    // mark segment as free and merge it with free neighbours
+    // return 'true' if removed
+    bool remove_segment(void* memory) noexcept;
+
+    // binary search of used segment by memory
+    // return 'segment entry' or 'nullptr' if memory is not begin of used segment
+    segment_entry_t* find_segment(void const* memory) const noexcept;
+
+public:
+    segment_entry_t* begin() const noexcept { return xxentries; }
+    segment_entry_t* end() const noexcept { return xxentries + xxcount; }
+
+    std::size_t count() const noexcept { return xxcount; }
+    std::size_t capacity() const noexcept { return xxcapacity; }
+
+    char* memory() const noexcept { return xxmemory; }
+    std::size_t bytes() const noexcept { return xxbytes; }
+
+private:
+    // return 'true' if inserted
+    bool insert(std::size_t index, segment_entry_t entry) noexcept;
+    void erase(std::size_t index) noexcept;
+
+private:
+    char* xxmemory = nullptr;
+    std::size_t xxbytes = 0;
+
+    segment_entry_t* xxentries = nullptr;
+    std::size_t xxcount = 0;
+    std::size_t xxcapacity = 0;
+};
+
+} // namespace eightmory
+
+#endif // EIGHTMORY_TABLE_HPP
@@ -0,0 +1,171 @@
+#ifndef EIGHTMORY_TAGS_HPP
+#define EIGHTMORY_TAGS_HPP
+
+#include <Eightmory/Core.hpp>
+
+#include <cstddef> // size_t
+#include <cstdint> // uint32_t
+#include <array> // array
+
+namespace eightmory
+{
+
+// shared heap with per-tag live bytes and optional hard budgets
+// tag is stored in spare bits of segment header, budgets fail before search
+template <typename ManagerType>
+class basic_tagged_segment_manager_t
+{
+public:
+    using manager_type = ManagerType;
+    using segment_type = typename ManagerType::segment_type;
+
+    static constexpr auto tag_count = segment_type::max_tag + 1;
+    static constexpr auto unlimited = std::size_t(-1);
+
+public:
+    basic_tagged_segment_manager_t(void* memory, std::size_t bytes) noexcept : xxmanager(memory, bytes)
+    {
+        xxbudget.fill(unlimited);
+    }
+
+public:
+    // allocate segment of given size in range [size, size + sizeof(segment_type)) for tag
+    // return 'pointer to segment memory' or 'nullptr' if tag budget would be exceeded
+    [[nodiscard]] void* add_segment(std::size_t size, std::uint32_t tag) noexcept
+    {
+        return add_segment(size, xxmanager.begin(), tag);
+    }
+
+    [[nodiscard]] void* add_segment(std::size_t size, segment_type* hint, std::uint32_t tag) noexcept
+    {
+        if (tag >= tag_count || !is_within_budget(tag, size))
+        {
+            return fail(tag);
+        }
+
+        auto memory = xxmanager.add_segment(size, hint, tag);
+        if (memory == nullptr)
+        {
+            return nullptr;
+        }
+
+        // segment may be up to header size greater than requested
+        auto const granted = segment_type::segment(memory)->size;
+        if (!is_within_budget(tag, granted))
+        {
+            xxmanager.remove_segment(memory);
+            return fail(tag);
+        }
+
+        xxlive_bytes[tag] += granted;
+        return memory;
+    }
+
+    // extend segment using available free rhs segments
+    // return 'true' if extended within tag budget
+    bool extend_segment(void* memory) noexcept
+    {
+        auto const segment = segment_type::segment(memory);
+        auto const tag = segment_tag(segment);
+
+        // bytes of free rhs segments, which will be merged
+        auto grow = std::size_t(0);
+        for (auto rhs = segment->next(); rhs != xxmanager.end() && !rhs->is_used; rhs = rhs->next())
+        {
+            grow += sizeof(segment_type) + rhs->size;
+        }
+
+        if (!is_within_budget(tag, grow))
+        {
+            fail(tag);
+            return false;
+        }
+        auto const prev_size = segment->size;
+        return update(segment, tag, prev_size, xxmanager.extend_segment(memory));
+    }
+
+    // extend segment of given extra size in range [size, size + sizeof(segment_type))
+    // return 'true' if extended within tag budget
+    bool extend_segment(void* memory, std::size_t size) noexcept
+    {
+        auto const segment = segment_type::segment(memory);
+        auto const tag = segment_tag(segment);
+
+        // extended segment cannot be shrunk back, so worst case is checked
+        if (!is_within_budget(tag, size + sizeof(segment_type) - 1))
+        {
+            fail(tag);
+            return false;
+        }
+        auto const prev_size = segment->size;
+        return update(segment, tag, prev_size, xxmanager.extend_segment(memory, size));
+    }
+
+    bool remove_segment(void* memory) noexcept
+    {
+        auto const segment = segment_type::segment(memory);
+        auto const tag = segment_tag(segment);
+        auto const size = segment->size;
+
+        if (!xxmanager.remove_segment(memory))
+        {
+            return false;
+        }
+
+        xxlive_bytes[tag] -= size;
+        return true;
+    }
+
+public:
+    // return 'tag of used segment'
+    static std::uint32_t tag(void* memory) noexcept { return segment_tag(segment_type::segment(memory)); }
+
+    std::size_t live_bytes(std::uint32_t tag) const noexcept { return xxlive_bytes[tag]; }
+    std::size_t failure_count(std::uint32_t tag) const noexcept { return xxfailure_count[tag]; }
+
+    std::size_t budget(std::uint32_t tag) const noexcept { return xxbudget[tag]; }
+
+    // budget lower than live bytes fails all further allocations of tag
+    void set_budget(std::uint32_t tag, std::size_t bytes) noexcept { xxbudget[tag] = bytes; }
+
+    manager_type& manager() noexcept { return xxmanager; }
+    manager_type const& manager() const noexcept { return xxmanager; }
+
+private:
+    bool is_within_budget(std::uint32_t tag, std::size_t size) const noexcept
+    {
+        return xxbudget[tag] == unlimited
+            || (xxlive_bytes[tag] <= xxbudget[tag] && size <= xxbudget[tag] - xxlive_bytes[tag]);
+    }
+
+    void* fail(std::uint32_t tag) noexcept
+    {
+        if (tag < tag_count)
+        {
+            ++xxfailure_count[tag];
+        }
+        return nullptr;
+    }
+
+    bool update(segment_type* segment, std::uint32_t tag, std::size_t prev_size, bool is_extended) noexcept
+    {
+        if (is_extended)
+        {
+            xxlive_bytes[tag] += segment->size - prev_size;
+        }
+        return is_extended;
+    }
+
+private:
+    manager_type xxmanager;
+
+    std::array<std::size_t, tag_count> xxlive_bytes{};
+    std::array<std::size_t, tag_count> xxbudget{};
+    std::array<std::size_t, tag_count> xxfailure_count{};
+};
+
+using tagged_segment_manager_t = basic_tagged_segment_manager_t<basic_segment_manager_t<first_fit_t, lazy_coalesce_t, tagged_segment_t>>;
+
+} // namespace eightmory
+
+#endif // EIGHTMORY_TAGS_HPP
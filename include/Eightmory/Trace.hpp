@@ -0,0 +1,171 @@
+#ifndef EIGHTMORY_TRACE_HPP
+#define EIGHTMORY_TRACE_HPP
+
+#include <cstddef> // size_t
+#include <cstdint> // uint64_t, uint8_t
+#include <cstdio> // FILE
+
+namespace eightmory
+{
+
+enum class trace_op_t : std::uint8_t
+{
+    add_segment = 1,
+    extend_segment = 2,
+    extend_segment_size = 3,
+    remove_segment = 4,
+};
+
+struct trace_record_t
+{
+    trace_op_t op = trace_op_t::add_segment;
+    bool is_success = false;
+
+    // requested size, 0 for extend_segment and remove_segment
+    std::size_t size = 0;
+
+    // offset of segment memory from heap begin: returned by add_segment or passed to others
+    std::size_t offset = 0;
+};
+
+// binary trace layout, all values are little endian:
+// [magic 8] [version 4] [segment_bytes 4] [bytes 8]
+// records of [op 1, success in high bit] [size 8] [offset 8], until end of file
+struct trace_header_t
+{
+    std::uint32_t version = 0;
+    std::uint32_t segment_bytes = 0;
+    std::uint64_t bytes = 0;
+
+    static constexpr char magic[8] = {'8', 'M', 'R', 'Y', 'T', 'R', 'A', 'C'};
+    static constexpr std::uint32_t current_version = 1;
+    static constexpr std::size_t header_bytes = 24;
+    static constexpr std::size_t record_bytes = 17;
+};
+
+class EIGHTMORY_API trace_writer_t
+{
+public:
+    trace_writer_t() noexcept = default;
+    ~trace_writer_t();
+
+    trace_writer_t(trace_writer_t const&) = delete;
+    trace_writer_t& operator=(trace_writer_t const&) = delete;
+
+public:
+    // return 'true' if opened
+    bool open(char const* path, std::size_t segment_bytes, std::size_t bytes) noexcept;
+
+    // return 'true' if written
+    bool write(trace_record_t const& record) noexcept;
+
+    // return 'true' if all records were written
+    bool close() noexcept;
+
+    bool is_open() const noexcept { return xxfile != nullptr; }
+
+private:
+    std::FILE* xxfile = nullptr;
+    bool xxis_failed = false;
+};
+
+class EIGHTMORY_API trace_reader_t
+{
+public:
+    trace_reader_t() noexcept = default;
+    ~trace_reader_t();
+
+    trace_reader_t(trace_reader_t const&) = delete;
+    trace_reader_t& operator=(trace_reader_t const&) = delete;
+
+public:
+    // return 'true' if opened and header is valid
+    bool open(char const* path) noexcept;
+
+    // return 'true' if record was read, 'false' at end of trace
+    bool read(trace_record_t& record) noexcept;
+
+    void close() noexcept;
+
+    trace_header_t const& header() const noexcept { return xxheader; }
+
+private:
+    std::FILE* xxfile = nullptr;
+    trace_header_t xxheader;
+};
+
+// records all calls of wrapped manager to trace
+template <typename ManagerType>
+class recorded_segment_manager_t
+{
+public:
+    using manager_type = ManagerType;
+    using segment_type = typename ManagerType::segment_type;
+
+    static constexpr auto npos = std::size_t(-1);
+
+public:
+    recorded_segment_manager_t(manager_type& manager, trace_writer_t& writer) noexcept
+        : xxmanager(manager), xxwriter(writer) {}
+
+public:
+    [[nodiscard]] void* add_segment(std::size_t size) noexcept
+    {
+        auto memory = xxmanager.add_segment(size);
+        record(trace_op_t::add_segment, memory != nullptr, size, memory);
+        return memory;
+    }
+
+    [[nodiscard]] void* add_segment(std::size_t size, segment_type* hint) noexcept
+    {
+        auto memory = xxmanager.add_segment(size, hint);
+        record(trace_op_t::add_segment, memory != nullptr, size, memory);
+        return memory;
+    }
+
+    bool extend_segment(void* memory) noexcept
+    {
+        auto const is_extended = xxmanager.extend_segment(memory);
+        record(trace_op_t::extend_segment, is_extended, 0, memory);
+        return is_extended;
+    }
+
+    bool extend_segment(void* memory, std::size_t size) noexcept
+    {
+        auto const is_extended = xxmanager.extend_segment(memory, size);
+        record(trace_op_t::extend_segment_size, is_extended, size, memory);
+        return is_extended;
+    }
+
+    bool remove_segment(void* memory) noexcept
+    {
+        auto const is_removed = xxmanager.remove_segment(memory);
+        record(trace_op_t::remove_segment, is_removed, 0, memory);
+        return is_removed;
+    }
+
+public:
+    manager_type& manager() const noexcept { return xxmanager; }
+
+private:
+    void record(trace_op_t op, bool is_success, std::size_t size, void* memory) noexcept
+    {
+        trace_record_t record;
+        record.op = op;
+        record.is_success = is_success;
+        record.size = size;
+        record.offset = memory == nullptr ? npos : static_cast<std::size_t>
+        (
+            reinterpret_cast<char*>(memory) - reinterpret_cast<char*>(xxmanager.begin())
+        );
+        xxwriter.write(record);
+    }
+
+private:
+    manager_type& xxmanager;
+    trace_writer_t& xxwriter;
+};
+
+} // namespace eightmory
+
+#endif // EIGHTMORY_TRACE_HPP
@@ -0,0 +1,130 @@
+#ifndef EIGHTMORY_ZEROED_HPP
+#define EIGHTMORY_ZEROED_HPP
+
+#include <Eightmory/Core.hpp>
+
+#include <cstddef> // size_t
+
+namespace eightmory
+{
+
+// blocks of at least this size are cleared by non-temporal stores, where available,
+// since they would only evict useful cache lines
+inline constexpr auto non_temporal_clear_bytes = std::size_t(1) << 20;
+
+// fill memory with zeros, using wide non-temporal stores for big blocks
+EIGHTMORY_API void clear_memory(void* memory, std::size_t bytes) noexcept;
+
+// manager, which knows that bytes after clean offset were never written
+// so zeroed allocation clears only bytes before clean offset
+template <typename ManagerType>
+class basic_zeroed_segment_manager_t
+{
+public:
+    using manager_type = ManagerType;
+    using segment_type = typename ManagerType::segment_type;
+
+public:
+    // is_zeroed tells that memory is filled with zeros, like fresh mapped pages
+    basic_zeroed_segment_manager_t(void* memory, std::size_t bytes, bool is_zeroed) noexcept
+        : xxmanager(memory, bytes), xxclean(is_zeroed ? sizeof(segment_type) : bytes) {}
+
+public:
+    [[nodiscard]] void* add_segment(std::size_t size) noexcept
+    {
+        auto memory = xxmanager.add_segment(size);
+        if (memory != nullptr)
+        {
+            touch(memory);
+        }
+        return memory;
+    }
+
+    // allocate segment of given size in range [size, size + sizeof(segment_type)), filled with zeros
+    // return 'pointer to segment memory'
+    [[nodiscard]] void* add_zeroed_segment(std::size_t size) noexcept
+    {
+        auto memory = xxmanager.add_segment(size);
+        if (memory == nullptr)
+        {
+            return nullptr;
+        }
+
+        auto const begin = offset(memory);
+        auto const end = begin + size;
+        auto const dirty_end = end < xxclean ? end : xxclean;
+        if (begin < dirty_end)
+        {
+            clear_memory(memory, dirty_end - begin);
+            xxcleared_bytes += dirty_end - begin;
+        }
+        xxskipped_bytes += end - (begin < dirty_end ? dirty_end : begin);
+
+        touch(memory);
+        return memory;
+    }
+
+    bool extend_segment(void* memory) noexcept
+    {
+        auto const is_extended = xxmanager.extend_segment(memory);
+        if (is_extended)
+        {
+            touch(memory);
+        }
+        return is_extended;
+    }
+
+    bool extend_segment(void* memory, std::size_t size) noexcept
+    {
+        auto const is_extended = xxmanager.extend_segment(memory, size);
+        if (is_extended)
+        {
+            touch(memory);
+        }
+        return is_extended;
+    }
+
+    bool remove_segment(void* memory) noexcept
+    {
+        return xxmanager.remove_segment(memory);
+    }
+
+public:
+    // return 'offset from heap begin', after which all bytes are zero
+    std::size_t clean_offset() const noexcept { return xxclean; }
+
+    std::size_t cleared_bytes() const noexcept { return xxcleared_bytes; }
+    std::size_t skipped_bytes() const noexcept { return xxskipped_bytes; }
+
+    manager_type const& manager() const noexcept { return xxmanager; }
+
+private:
+    std::size_t offset(void* memory) const noexcept
+    {
+        return static_cast<std::size_t>(reinterpret_cast<char*>(memory) - reinterpret_cast<char*>(xxmanager.begin()));
+    }
+
+    // segment may be written by user, and rhs header by manager
+    void touch(void* memory) noexcept
+    {
+        auto const end = offset(memory) + segment_type::segment(memory)->size + sizeof(segment_type);
+        auto const bytes = xxmanager.bytes();
+        if (end > xxclean)
+        {
+            xxclean = end < bytes ? end : bytes;
+        }
+    }
+
+private:
+    manager_type xxmanager;
+    std::size_t xxclean = 0;
+
+    std::size_t xxcleared_bytes = 0;
+    std::size_t xxskipped_bytes = 0;
+};
+
+using zeroed_segment_manager_t = basic_zeroed_segment_manager_t<segment_manager_t>;
+
+} // namespace eightmory
+
+#endif // EIGHTMORY_ZEROED_HPP
@@ -0,0 +1,129 @@
+#include <Eightmory/Counters.hpp>
+
+#ifdef __linux__
+#include <linux/perf_event.h> // perf_event_attr
+#include <sys/ioctl.h> // ioctl
+#include <sys/syscall.h> // SYS_perf_event_open
+#include <unistd.h> // syscall, read, close
+
+#include <cstring> // memset
+#endif // __linux__
+
+namespace eightmory
+{
+
+perf_counters_t::~perf_counters_t()
+{
+    close();
+}
+
+#ifdef __linux__
+static int open_counter(std::uint32_t type, std::uint64_t config, int leader) noexcept
+{
+    perf_event_attr attribute;
+    std::memset(&attribute, 0, sizeof(attribute));
+    attribute.size = sizeof(attribute);
+    attribute.type = type;
+    attribute.config = config;
+    attribute.disabled = leader == -1;
+    attribute.exclude_kernel = 1;
+    attribute.exclude_hv = 1;
+    attribute.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    return static_cast<int>(syscall(SYS_perf_event_open, &attribute, 0, -1, leader, 0));
+}
+
+bool perf_counters_t::open() noexcept
+{
+    close();
+
+    struct config_t
+    {
+        std::uint32_t type;
+        std::uint64_t config;
+    };
+
+    constexpr config_t configs[perf_sample_t::counter_count] =
+    {
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    };
+
+    // first available counter leads group, so all of them are enabled at once
+    for (std::size_t index = 0; index < perf_sample_t::counter_count; ++index)
+    {
+        xxfiles[index] = open_counter(configs[index].type, configs[index].config, xxleader);
+        if (xxfiles[index] != -1 && xxleader == -1)
+        {
+            xxleader = xxfiles[index];
+        }
+    }
+    return xxleader != -1;
+}
+
+void perf_counters_t::close() noexcept
+{
+    for (auto& file : xxfiles)
+    {
+        if (file != -1)
+        {
+            ::close(file);
+            file = -1;
+        }
+    }
+    xxleader = -1;
+}
+
+bool perf_counters_t::start() noexcept
+{
+    return xxleader != -1
+        && ioctl(xxleader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP) != -1
+        && ioctl(xxleader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP) != -1;
+}
+
+bool perf_counters_t::stop() noexcept
+{
+    return xxleader != -1 && ioctl(xxleader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP) != -1;
+}
+
+bool perf_counters_t::read(perf_sample_t& sample) const noexcept
+{
+    sample = perf_sample_t{};
+    if (xxleader == -1)
+    {
+        return false;
+    }
+
+    for (std::size_t index = 0; index < perf_sample_t::counter_count; ++index)
+    {
+        // value, time enabled, time running
+        std::uint64_t data[3];
+        if (xxfiles[index] == -1 || ::read(xxfiles[index], data, sizeof(data)) != sizeof(data) || data[2] == 0)
+        {
+            continue;
+        }
+
+        sample.values[index] = data[2] < data[1]
+            ? static_cast<std::uint64_t>(double(data[0]) * double(data[1]) / double(data[2]))
+            : data[0];
+        sample.is_available[index] = true;
+    }
+    return true;
+}
+#else
+bool perf_counters_t::open() noexcept { return false; }
+void perf_counters_t::close() noexcept {}
+bool perf_counters_t::start() noexcept { return false; }
+bool perf_counters_t::stop() noexcept { return false; }
+
+bool perf_counters_t::read(perf_sample_t& sample) const noexcept
+{
+    sample = perf_sample_t{};
+    return false;
+}
+#endif // __linux__
+
+} // namespace eightmory
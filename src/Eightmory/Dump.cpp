@@ -0,0 +1,151 @@
+#include <Eightmory/Dump.hpp>
+
+#include <cstring> // memcmp
+
+#include "Endian.hpp" // store_le, load_le
+
+namespace eightmory
+{
+
+static constexpr auto used_bit = std::uint64_t(1) << 63;
+
+segment_dump_writer_t::~segment_dump_writer_t()
+{
+    close();
+}
+
+bool segment_dump_writer_t::open(char const* path, std::size_t segment_bytes, std::size_t bytes) noexcept
+{
+    close();
+
+    xxfile = std::fopen(path, "wb");
+    if (xxfile == nullptr)
+    {
+        return false;
+    }
+
+    xxcount = 0;
+    xxis_failed = false;
+
+    // count is written on close
+    unsigned char header[segment_dump_header_t::header_bytes] = {};
+    std::memcpy(header, segment_dump_header_t::magic, sizeof(segment_dump_header_t::magic));
+    store_le(header + 8, segment_dump_header_t::current_version, 4);
+    store_le(header + 12, segment_bytes, 4);
+    store_le(header + 16, bytes, 8);
+
+    xxis_failed = std::fwrite(header, sizeof(header), 1, xxfile) != 1;
+    return !xxis_failed;
+}
+
+bool segment_dump_writer_t::write(segment_info_t const& info) noexcept
+{
+    if (xxfile == nullptr)
+    {
+        return false;
+    }
+
+    unsigned char record[segment_dump_header_t::record_bytes] = {};
+    store_le(record, info.offset, 8);
+    store_le(record + 8, info.size | (info.is_used ? used_bit : 0), 8);
+    store_le(record + 16, info.tag, 4);
+
+    if (std::fwrite(record, sizeof(record), 1, xxfile) != 1)
+    {
+        xxis_failed = true;
+        return false;
+    }
+
+    ++xxcount;
+    return true;
+}
+
+bool segment_dump_writer_t::close() noexcept
+{
+    if (xxfile == nullptr)
+    {
+        return false;
+    }
+
+    unsigned char count[8];
+    store_le(count, xxcount, 8);
+
+    auto success = !xxis_failed;
+    success &= std::fseek(xxfile, 24, SEEK_SET) == 0;
+    success &= std::fwrite(count, sizeof(count), 1, xxfile) == 1;
+    success &= std::fclose(xxfile) == 0;
+
+    xxfile = nullptr;
+    return success;
+}
+
+segment_dump_reader_t::~segment_dump_reader_t()
+{
+    close();
+}
+
+bool segment_dump_reader_t::open(char const* path) noexcept
+{
+    close();
+
+    xxfile = std::fopen(path, "rb");
+    if (xxfile == nullptr)
+    {
+        return false;
+    }
+
+    unsigned char header[segment_dump_header_t::header_bytes];
+    if
+    (
+        std::fread(header, sizeof(header), 1, xxfile) != 1 ||
+        std::memcmp(header, segment_dump_header_t::magic, sizeof(segment_dump_header_t::magic)) != 0 ||
+        load_le(header + 8, 4) != segment_dump_header_t::current_version
+    )
+    {
+        close();
+        return false;
+    }
+
+    xxheader.version = static_cast<std::uint32_t>(load_le(header + 8, 4));
+    xxheader.segment_bytes = static_cast<std::uint32_t>(load_le(header + 12, 4));
+    xxheader.bytes = load_le(header + 16, 8);
+    xxheader.count = load_le(header + 24, 8);
+    xxread_count = 0;
+    return true;
+}
+
+bool segment_dump_reader_t::read(segment_info_t& info) noexcept
+{
+    if (xxfile == nullptr || xxread_count == xxheader.count)
+    {
+        return false;
+    }
+
+    unsigned char record[segment_dump_header_t::record_bytes];
+    if (std::fread(record, sizeof(record), 1, xxfile) != 1)
+    {
+        return false;
+    }
+
+    auto const size = load_le(record + 8, 8);
+
+    info.offset = static_cast<std::size_t>(load_le(record, 8));
+    info.size = static_cast<std::size_t>(size & ~used_bit);
+    info.is_used = (size & used_bit) != 0;
+    info.tag = static_cast<std::uint32_t>(load_le(record + 16, 4));
+
+    ++xxread_count;
+    return true;
+}
+
+void segment_dump_reader_t::close() noexcept
+{
+    if (xxfile != nullptr)
+    {
+        std::fclose(xxfile);
+        xxfile = nullptr;
+    }
+    xxheader = segment_dump_header_t{};
+}
+
+} // namespace eightmory
@@ -0,0 +1,31 @@
+#ifndef EIGHTMORY_ENDIAN_HPP
+#define EIGHTMORY_ENDIAN_HPP
+
+#include <cstddef> // size_t
+#include <cstdint> // uint64_t
+
+namespace eightmory
+{
+
+// internal helpers of file formats, which store integers in little endian order
+inline void store_le(unsigned char* bytes, std::uint64_t value, std::size_t count) noexcept
+{
+    for (std::size_t index = 0; index < count; ++index)
+    {
+        bytes[index] = static_cast<unsigned char>(value >> (8 * index));
+    }
+}
+
+inline std::uint64_t load_le(unsigned char const* bytes, std::size_t count) noexcept
+{
+    auto value = std::uint64_t(0);
+    for (std::size_t index = 0; index < count; ++index)
+    {
+        value |= std::uint64_t(bytes[index]) << (8 * index);
+    }
+    return value;
+}
+
+} // namespace eightmory
+
+#endif // EIGHTMORY_ENDIAN_HPP
@@ -0,0 +1,161 @@
+#include <Eightmory/Epoch.hpp>
+
+#include <cstring> // memmove
+#include <thread> // yield
+
+namespace eightmory
+{
+
+bool epoch_domain_t::try_advance() noexcept
+{
+    auto epoch = xxepoch.load(std::memory_order_seq_cst);
+    for (auto& slot : xxslots)
+    {
+        auto const state = slot.state.load(std::memory_order_seq_cst);
+        if ((state & active_bit) != 0 && (state >> epoch_shift) != epoch)
+        {
+            return false;
+        }
+    }
+
+    // other thread may advance it first, that is also progress
+    xxepoch.compare_exchange_strong(epoch, epoch + 1, std::memory_order_seq_cst);
+    return true;
+}
+
+epoch_participant_t::epoch_participant_t(epoch_domain_t& domain) noexcept : xxdomain(domain)
+{
+    for (auto& slot : domain.xxslots)
+    {
+        auto expected = std::uint64_t(0);
+        if (slot.state.compare_exchange_strong(expected, epoch_domain_t::used_bit, std::memory_order_acq_rel))
+        {
+            xxslot = &slot;
+            return;
+        }
+    }
+}
+
+epoch_participant_t::~epoch_participant_t()
+{
+    if (xxslot == nullptr)
+    {
+        return;
+    }
+
+    synchronize();
+    xxslot->state.store(0, std::memory_order_release);
+}
+
+void epoch_participant_t::enter() noexcept
+{
+    if (xxslot == nullptr || xxdepth++ != 0)
+    {
+        return;
+    }
+
+    // announce epoch, then validate it, so advance cannot skip over this reader
+    auto epoch = xxdomain.xxepoch.load(std::memory_order_seq_cst);
+    for (;;)
+    {
+        xxslot->state.store((epoch << epoch_domain_t::epoch_shift) | epoch_domain_t::active_bit | epoch_domain_t::used_bit, std::memory_order_seq_cst);
+
+        auto const current = xxdomain.xxepoch.load(std::memory_order_seq_cst);
+        if (current == epoch)
+        {
+            return;
+        }
+        epoch = current;
+    }
+}
+
+void epoch_participant_t::leave() noexcept
+{
+    if (xxslot == nullptr || --xxdepth != 0)
+    {
+        return;
+    }
+
+    xxslot->state.store(epoch_domain_t::used_bit, std::memory_order_release);
+}
+
+bool epoch_participant_t::retire(void* memory) noexcept
+{
+    if (xxslot == nullptr)
+    {
+        return false;
+    }
+
+    if (xxcount == capacity)
+    {
+        xxdomain.try_advance();
+        reclaim();
+    }
+
+    // blocking is only safe outside of critical section, since this reader holds epoch otherwise
+    while (xxcount == capacity)
+    {
+        if (xxdepth != 0)
+        {
+            return false;
+        }
+
+        std::this_thread::yield();
+        xxdomain.try_advance();
+        reclaim();
+    }
+
+    xxmemory[xxcount] = memory;
+    xxepochs[xxcount] = xxdomain.epoch();
+    ++xxcount;
+
+    if (xxcount % reclaim_threshold == 0)
+    {
+        xxdomain.try_advance();
+        reclaim();
+    }
+    return true;
+}
+
+std::size_t epoch_participant_t::reclaim() noexcept
+{
+    auto const epoch = xxdomain.epoch();
+
+    auto count = std::size_t(0);
+    while (count < xxcount && xxepochs[count] + 2 <= epoch)
+    {
+        ++count;
+    }
+
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    xxdomain.xxreclaim(xxdomain.xxcontext, xxmemory, count);
+
+    xxcount -= count;
+    std::memmove(xxmemory, xxmemory + count, xxcount * sizeof(void*));
+    std::memmove(xxepochs, xxepochs + count, xxcount * sizeof(std::uint64_t));
+    return count;
+}
+
+void epoch_participant_t::synchronize() noexcept
+{
+    if (xxslot == nullptr || xxdepth != 0)
+    {
+        return;
+    }
+
+    auto const target = xxdomain.epoch() + 2;
+    while (xxdomain.epoch() < target)
+    {
+        if (!xxdomain.try_advance())
+        {
+            std::this_thread::yield();
+        }
+    }
+    reclaim();
+}
+
+} // namespace eightmory
@@ -0,0 +1,404 @@
+#include <Eightmory/Guarded.hpp>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif // NOMINMAX
+#include <windows.h> // VirtualAlloc, VirtualProtect, AddVectoredExceptionHandler
+
+#include <cstdio> // fprintf
+#else
+#include <signal.h> // sigaction
+#include <sys/mman.h> // mmap, mprotect, madvise
+#include <unistd.h> // sysconf, write
+#endif // _WIN32
+
+#include <cstdint> // uintptr_t
+
+namespace eightmory
+{
+
+static guarded_pool_t* installed_pool = nullptr;
+
+static char const* fault_name(guarded_fault_t fault) noexcept
+{
+    switch (fault)
+    {
+    case guarded_fault_t::overflow: return "heap-buffer-overflow";
+    case guarded_fault_t::underflow: return "heap-buffer-underflow";
+    case guarded_fault_t::use_after_free: return "heap-use-after-free";
+    case guarded_fault_t::wild_access: return "wild-access";
+    default: return "none";
+    }
+}
+
+#ifdef _WIN32
+static std::size_t system_page_size() noexcept
+{
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return static_cast<std::size_t>(info.dwPageSize);
+}
+
+static char* reserve_pages(std::size_t bytes) noexcept
+{
+    return static_cast<char*>(VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_NOACCESS));
+}
+
+static void release_pages(char* memory, std::size_t) noexcept
+{
+    VirtualFree(memory, 0, MEM_RELEASE);
+}
+
+static bool protect_page(char* page, std::size_t bytes, bool is_accessible) noexcept
+{
+    DWORD old_protect;
+    return VirtualProtect(page, bytes, is_accessible ? PAGE_READWRITE : PAGE_NOACCESS, &old_protect) != 0;
+}
+
+static void discard_page(char* page, std::size_t bytes) noexcept
+{
+    VirtualAlloc(page, bytes, MEM_RESET, PAGE_NOACCESS);
+}
+
+static void* exception_handler = nullptr;
+
+static LONG CALLBACK guarded_exception_handler(EXCEPTION_POINTERS* info)
+{
+    auto const record = info->ExceptionRecord;
+    if (record->ExceptionCode == EXCEPTION_ACCESS_VIOLATION && record->NumberParameters >= 2 && installed_pool != nullptr)
+    {
+        auto const address = reinterpret_cast<void const*>(record->ExceptionInformation[1]);
+        if (installed_pool->contains(address))
+        {
+            auto const report = installed_pool->describe(address);
+            std::fprintf
+            (
+                stderr, "eightmory: %s at %p, allocation of %zu bytes at %p\n",
+                fault_name(report.fault), report.address, report.size, report.memory
+            );
+        }
+    }
+    return EXCEPTION_CONTINUE_SEARCH;
+}
+#else
+static std::size_t system_page_size() noexcept
+{
+    return static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+}
+
+static char* reserve_pages(std::size_t bytes) noexcept
+{
+    auto memory = mmap(nullptr, bytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return memory == MAP_FAILED ? nullptr : static_cast<char*>(memory);
+}
+
+static void release_pages(char* memory, std::size_t bytes) noexcept
+{
+    munmap(memory, bytes);
+}
+
+static bool protect_page(char* page, std::size_t bytes, bool is_accessible) noexcept
+{
+    return mprotect(page, bytes, is_accessible ? PROT_READ | PROT_WRITE : PROT_NONE) == 0;
+}
+
+static void discard_page(char* page, std::size_t bytes) noexcept
+{
+    madvise(page, bytes, MADV_DONTNEED);
+}
+
+// macOS reports access to protected page as SIGBUS, other systems as SIGSEGV
+static struct sigaction previous_segv_action;
+static struct sigaction previous_bus_action;
+
+// async-signal-safe formatting
+static char* append_text(char* buffer, char const* text) noexcept
+{
+    while (*text != '\0') *buffer++ = *text++;
+    return buffer;
+}
+
+static char* append_number(char* buffer, std::uintptr_t value, unsigned base) noexcept
+{
+    char digits[32];
+    auto count = 0;
+    do
+    {
+        digits[count++] = "0123456789abcdef"[value % base];
+        value /= base;
+    }
+    while (value != 0);
+
+    if (base == 16) buffer = append_text(buffer, "0x");
+    while (count != 0) *buffer++ = digits[--count];
+    return buffer;
+}
+
+// pass fault to previous handler, handler of pool stays installed
+static void chain_signal(int signal, siginfo_t* info, void* context) noexcept
+{
+    auto& previous = signal == SIGBUS ? previous_bus_action : previous_segv_action;
+    if ((previous.sa_flags & SA_SIGINFO) != 0)
+    {
+        if (previous.sa_sigaction != nullptr) previous.sa_sigaction(signal, info, context);
+        return;
+    }
+    if (previous.sa_handler != SIG_DFL && previous.sa_handler != SIG_IGN)
+    {
+        previous.sa_handler(signal);
+        return;
+    }
+
+    // default action, faulting instruction is restarted and terminates process
+    sigaction(signal, &previous, nullptr);
+}
+
+static void guarded_signal_handler(int signal, siginfo_t* info, void* context)
+{
+    if (installed_pool != nullptr && installed_pool->contains(info->si_addr))
+    {
+        auto const report = installed_pool->describe(info->si_addr);
+
+        char buffer[256];
+        auto end = append_text(buffer, "eightmory: ");
+        end = append_text(end, fault_name(report.fault));
+        end = append_text(end, " at ");
+        end = append_number(end, reinterpret_cast<std::uintptr_t>(report.address), 16);
+        end = append_text(end, ", allocation of ");
+        end = append_number(end, report.size, 10);
+        end = append_text(end, " bytes at ");
+        end = append_number(end, reinterpret_cast<std::uintptr_t>(report.memory), 16);
+        end = append_text(end, "\n");
+
+        [[maybe_unused]] auto const written = write(2, buffer, static_cast<std::size_t>(end - buffer));
+    }
+
+    chain_signal(signal, info, context);
+}
+#endif // _WIN32
+
+guarded_pool_t::~guarded_pool_t()
+{
+    close();
+}
+
+bool guarded_pool_t::create(std::size_t slot_count) noexcept
+{
+    close();
+    if (slot_count == 0)
+    {
+        return false;
+    }
+
+    xxpage_size = system_page_size();
+    xxbytes = (2 * slot_count + 1) * xxpage_size;
+    xxbase = reserve_pages(xxbytes);
+    if (xxbase == nullptr)
+    {
+        xxbytes = 0;
+        return false;
+    }
+
+    xxslots.assign(slot_count, slot_t{});
+    xxfree.resize(slot_count);
+    for (std::size_t index = 0; index < slot_count; ++index)
+    {
+        xxfree[index] = static_cast<std::uint32_t>(index);
+    }
+    xxfree_head = 0;
+    xxfree_count = slot_count;
+    xxlive_count = 0;
+    return true;
+}
+
+void guarded_pool_t::close() noexcept
+{
+    if (installed_pool == this)
+    {
+        uninstall_fault_handler();
+    }
+
+    if (xxbase != nullptr)
+    {
+        release_pages(xxbase, xxbytes);
+    }
+
+    xxbase = nullptr;
+    xxbytes = 0;
+    xxslots.clear();
+    xxfree.clear();
+    xxfree_head = 0;
+    xxfree_count = 0;
+    xxlive_count = 0;
+}
+
+void* guarded_pool_t::allocate(std::size_t size, std::size_t align) noexcept
+{
+    if (xxfree_count == 0 || size > xxpage_size)
+    {
+        return nullptr;
+    }
+
+    auto const index = xxfree[xxfree_head];
+    auto const page = slot_memory(index);
+    if (!protect_page(page, xxpage_size, true))
+    {
+        return nullptr;
+    }
+
+    xxfree_head = (xxfree_head + 1) % xxfree.size();
+    --xxfree_count;
+    ++xxlive_count;
+
+    // right aligned, align must be power of two
+    // empty allocation takes single byte, so memory is still inside of slot
+    auto& slot = xxslots[index];
+    slot.size = size;
+    slot.offset = (xxpage_size - (size == 0 ? 1 : size)) & ~(align - 1);
+    slot.is_used = true;
+    slot.is_freed = false;
+    return page + slot.offset;
+}
+
+bool guarded_pool_t::deallocate(void* memory) noexcept
+{
+    if (!contains(memory))
+    {
+        return false;
+    }
+
+    auto const page_index = static_cast<std::size_t>(reinterpret_cast<char*>(memory) - xxbase) / xxpage_size;
+    if (page_index % 2 == 0)
+    {
+        return false;
+    }
+
+    auto const index = (page_index - 1) / 2;
+    auto& slot = xxslots[index];
+    if (!slot.is_used || slot_memory(index) + slot.offset != memory)
+    {
+        return false; // double or invalid free
+    }
+
+    auto const page = slot_memory(index);
+    discard_page(page, xxpage_size);
+    protect_page(page, xxpage_size, false);
+
+    slot.is_used = false;
+    slot.is_freed = true;
+
+    xxfree[(xxfree_head + xxfree_count) % xxfree.size()] = static_cast<std::uint32_t>(index);
+    ++xxfree_count;
+    --xxlive_count;
+    return true;
+}
+
+guarded_report_t guarded_pool_t::describe(void const* address) const noexcept
+{
+    guarded_report_t report;
+    report.address = address;
+    if (!contains(address))
+    {
+        return report;
+    }
+
+    auto const offset = static_cast<std::size_t>(reinterpret_cast<char const*>(address) - xxbase);
+    auto const page_index = offset / xxpage_size;
+
+    auto const fill = [this, &report](std::size_t index, guarded_fault_t fault)
+    {
+        report.fault = fault;
+        report.memory = slot_memory(index) + xxslots[index].offset;
+        report.size = xxslots[index].size;
+    };
+
+    if (page_index % 2 == 1)
+    {
+        auto const index = (page_index - 1) / 2;
+        auto const& slot = xxslots[index];
+        auto const memory = slot_memory(index) + slot.offset;
+        if (slot.is_freed)
+        {
+            fill(index, guarded_fault_t::use_after_free);
+        }
+        else if (!slot.is_used)
+        {
+            report.fault = guarded_fault_t::wild_access;
+        }
+        else if (reinterpret_cast<char const*>(address) < memory)
+        {
+            fill(index, guarded_fault_t::underflow);
+        }
+        else if (reinterpret_cast<char const*>(address) >= memory + slot.size)
+        {
+            fill(index, guarded_fault_t::overflow);
+        }
+        return report;
+    }
+
+    // guard page, blame closest used neighbour slot
+    auto const guard = page_index / 2;
+    if (guard > 0 && xxslots[guard - 1].is_used)
+    {
+        fill(guard - 1, guarded_fault_t::overflow);
+    }
+    else if (guard < xxslots.size() && xxslots[guard].is_used)
+    {
+        fill(guard, guarded_fault_t::underflow);
+    }
+    else
+    {
+        report.fault = guarded_fault_t::wild_access;
+    }
+    return report;
+}
+
+bool guarded_pool_t::install_fault_handler() noexcept
+{
+    if (installed_pool != nullptr || xxbase == nullptr)
+    {
+        return false;
+    }
+#ifdef _WIN32
+    exception_handler = AddVectoredExceptionHandler(1, guarded_exception_handler);
+    if (exception_handler == nullptr)
+    {
+        return false;
+    }
+#else
+    struct sigaction action = {};
+    action.sa_sigaction = guarded_signal_handler;
+    action.sa_flags = SA_SIGINFO;
+    sigemptyset(&action.sa_mask);
+    if (sigaction(SIGSEGV, &action, &previous_segv_action) != 0)
+    {
+        return false;
+    }
+    if (sigaction(SIGBUS, &action, &previous_bus_action) != 0)
+    {
+        sigaction(SIGSEGV, &previous_segv_action, nullptr);
+        return false;
+    }
+#endif // _WIN32
+    installed_pool = this;
+    return true;
+}
+
+void guarded_pool_t::uninstall_fault_handler() noexcept
+{
+    if (installed_pool != this)
+    {
+        return;
+    }
+#ifdef _WIN32
+    RemoveVectoredExceptionHandler(exception_handler);
+    exception_handler = nullptr;
+#else
+    sigaction(SIGSEGV, &previous_segv_action, nullptr);
+    sigaction(SIGBUS, &previous_bus_action, nullptr);
+#endif // _WIN32
+    installed_pool = nullptr;
+}
+
+} // namespace eightmory
@@ -0,0 +1,271 @@
+#include <Eightmory/Mapping.hpp>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif // NOMINMAX
+#include <windows.h> // CreateFileMappingA, MapViewOfFile
+#else
+#include <fcntl.h> // open
+#include <sys/mman.h> // mmap
+#include <sys/stat.h> // fstat
+#include <unistd.h> // ftruncate, close
+
+#include <cstdio> // snprintf
+#endif // _WIN32
+
+namespace eightmory
+{
+
+#ifdef _WIN32
+bool map_file(mapping_t& mapping, char const* path, std::size_t bytes) noexcept
+{
+    auto file = CreateFileA
+    (
+        path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+        bytes != 0 ? CREATE_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr
+    );
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (bytes != 0)
+    {
+        size.QuadPart = static_cast<LONGLONG>(bytes);
+        if (!SetFilePointerEx(file, size, nullptr, FILE_BEGIN) || !SetEndOfFile(file))
+        {
+            CloseHandle(file);
+            return false;
+        }
+    }
+    else if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    auto handle = CreateFileMappingA(file, nullptr, PAGE_READWRITE, 0, 0, nullptr);
+    if (handle == nullptr)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    auto memory = MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+    if (memory == nullptr)
+    {
+        CloseHandle(handle);
+        CloseHandle(file);
+        return false;
+    }
+
+    mapping.memory = memory;
+    mapping.bytes = static_cast<std::size_t>(size.QuadPart);
+    mapping.file = file;
+    mapping.handle = handle;
+    return true;
+}
+
+bool map_shared(mapping_t& mapping, char const* name, std::size_t bytes) noexcept
+{
+    HANDLE handle = nullptr;
+    if (bytes != 0)
+    {
+        auto const size = static_cast<unsigned long long>(bytes);
+        handle = CreateFileMappingA
+        (
+            INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+            static_cast<DWORD>(size >> 32), static_cast<DWORD>(size & 0xFFFFFFFF), name
+        );
+        if (handle != nullptr && GetLastError() == ERROR_ALREADY_EXISTS)
+        {
+            CloseHandle(handle);
+            return false;
+        }
+    }
+    else
+    {
+        handle = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, name);
+    }
+
+    if (handle == nullptr)
+    {
+        return false;
+    }
+
+    auto memory = MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+    if (memory == nullptr)
+    {
+        CloseHandle(handle);
+        return false;
+    }
+
+    MEMORY_BASIC_INFORMATION info;
+    if (VirtualQuery(memory, &info, sizeof(info)) == 0)
+    {
+        UnmapViewOfFile(memory);
+        CloseHandle(handle);
+        return false;
+    }
+
+    mapping.memory = memory;
+    mapping.bytes = bytes != 0 ? bytes : static_cast<std::size_t>(info.RegionSize);
+    mapping.file = nullptr;
+    mapping.handle = handle;
+    return true;
+}
+
+bool unlink_shared(char const*) noexcept
+{
+    // named mapping is destroyed with last handle
+    return true;
+}
+
+bool sync_mapping(mapping_t& mapping) noexcept
+{
+    return mapping.memory != nullptr && mapping.file != nullptr
+        && FlushViewOfFile(mapping.memory, 0)
+        && FlushFileBuffers(mapping.file);
+}
+
+void unmap(mapping_t& mapping) noexcept
+{
+    if (mapping.memory != nullptr)
+    {
+        UnmapViewOfFile(mapping.memory);
+        CloseHandle(mapping.handle);
+        if (mapping.file != nullptr)
+        {
+            CloseHandle(mapping.file);
+        }
+    }
+    mapping = mapping_t{};
+}
+#else
+bool map_file(mapping_t& mapping, char const* path, std::size_t bytes) noexcept
+{
+    auto file = bytes != 0 ? ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644) : ::open(path, O_RDWR);
+    if (file == -1)
+    {
+        return false;
+    }
+
+    if (bytes != 0)
+    {
+        if (::ftruncate(file, static_cast<off_t>(bytes)) != 0)
+        {
+            ::close(file);
+            return false;
+        }
+    }
+    else
+    {
+        struct stat status;
+        if (::fstat(file, &status) != 0 || status.st_size <= 0)
+        {
+            ::close(file);
+            return false;
+        }
+        bytes = static_cast<std::size_t>(status.st_size);
+    }
+
+    auto memory = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+    if (memory == MAP_FAILED)
+    {
+        ::close(file);
+        return false;
+    }
+
+    mapping.memory = memory;
+    mapping.bytes = bytes;
+    mapping.file = file;
+    return true;
+}
+
+// posix shared memory names must start with slash
+// return 'true' if name fits in path
+static bool shared_path(char (&path)[256], char const* name) noexcept
+{
+    auto const written = std::snprintf(path, sizeof(path), "%s%s", name[0] == '/' ? "" : "/", name);
+    return written > 0 && static_cast<std::size_t>(written) < sizeof(path);
+}
+
+bool map_shared(mapping_t& mapping, char const* name, std::size_t bytes) noexcept
+{
+    char path[256];
+    if (!shared_path(path, name))
+    {
+        return false;
+    }
+
+    auto const is_created = bytes != 0;
+    auto file = is_created
+        ? ::shm_open(path, O_RDWR | O_CREAT | O_EXCL, 0600)
+        : ::shm_open(path, O_RDWR, 0600);
+    if (file == -1)
+    {
+        return false;
+    }
+
+    if (is_created)
+    {
+        if (::ftruncate(file, static_cast<off_t>(bytes)) != 0)
+        {
+            ::close(file);
+            ::shm_unlink(path);
+            return false;
+        }
+    }
+    else
+    {
+        struct stat status;
+        if (::fstat(file, &status) != 0 || status.st_size <= 0)
+        {
+            ::close(file);
+            return false;
+        }
+        bytes = static_cast<std::size_t>(status.st_size);
+    }
+
+    auto memory = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+    if (memory == MAP_FAILED)
+    {
+        ::close(file);
+        if (is_created)
+        {
+            ::shm_unlink(path);
+        }
+        return false;
+    }
+
+    mapping.memory = memory;
+    mapping.bytes = bytes;
+    mapping.file = file;
+    return true;
+}
+
+bool unlink_shared(char const* name) noexcept
+{
+    char path[256];
+    return shared_path(path, name) && ::shm_unlink(path) == 0;
+}
+
+bool sync_mapping(mapping_t& mapping) noexcept
+{
+    return mapping.memory != nullptr && ::msync(mapping.memory, mapping.bytes, MS_SYNC) == 0;
+}
+
+void unmap(mapping_t& mapping) noexcept
+{
+    if (mapping.memory != nullptr)
+    {
+        ::munmap(mapping.memory, mapping.bytes);
+        ::close(mapping.file);
+    }
+    mapping = mapping_t{};
+}
+#endif // _WIN32
+
+} // namespace eightmory
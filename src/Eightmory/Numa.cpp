@@ -0,0 +1,420 @@
+#include <Eightmory/Numa.hpp>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif // NOMINMAX
+#include <windows.h> // VirtualAllocExNuma, GetNumaHighestNodeNumber, GetNumaAvailableMemoryNodeEx
+#else
+#include <sys/mman.h> // mmap
+#include <unistd.h> // sysconf
+#ifdef __linux__
+#include <sched.h> // sched_setaffinity
+#include <sys/syscall.h> // SYS_mbind, SYS_getcpu
+
+#include <cstdio> // fopen, snprintf
+#endif // __linux__
+#endif // _WIN32
+
+namespace eightmory
+{
+
+#ifdef _WIN32
+static std::size_t numa_node_ids(std::size_t* ids) noexcept
+{
+    ULONG highest = 0;
+    if (!GetNumaHighestNodeNumber(&highest))
+    {
+        ids[0] = 0;
+        return 1;
+    }
+
+    // nodes without memory, like cpu only nodes, cannot hold arena
+    // node ids are limited by max_numa_nodes, like node masks on linux
+    auto count = std::size_t(0);
+    for (std::size_t node = 0; node <= highest && node < max_numa_nodes; ++node)
+    {
+        ULONGLONG available = 0;
+        if (GetNumaAvailableMemoryNodeEx(static_cast<USHORT>(node), &available) && available != 0)
+        {
+            ids[count++] = node;
+        }
+    }
+
+    if (count == 0)
+    {
+        ids[count++] = 0;
+    }
+    return count;
+}
+
+std::size_t current_numa_node() noexcept
+{
+    PROCESSOR_NUMBER processor;
+    GetCurrentProcessorNumberEx(&processor);
+
+    USHORT node = 0;
+    return GetNumaProcessorNodeEx(&processor, &node) ? static_cast<std::size_t>(node) : 0;
+}
+
+static char* map_node_memory(std::size_t bytes, std::size_t node, std::size_t, numa_binding_t& binding) noexcept
+{
+    auto memory = VirtualAllocExNuma(GetCurrentProcess(), nullptr, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE, static_cast<DWORD>(node));
+    binding = numa_binding_t::bind;
+    if (memory == nullptr)
+    {
+        memory = VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+        binding = numa_binding_t::none;
+    }
+    return static_cast<char*>(memory);
+}
+
+static void unmap_node_memory(char* memory, std::size_t) noexcept
+{
+    VirtualFree(memory, 0, MEM_RELEASE);
+}
+
+static std::size_t system_page_size() noexcept
+{
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return static_cast<std::size_t>(info.dwPageSize);
+}
+#else
+#ifdef __linux__
+// parse list like "0-3,8,10-11"
+// return 'number of parsed ids'
+static std::size_t read_id_list(char const* path, std::size_t* ids, std::size_t max_count) noexcept
+{
+    auto file = std::fopen(path, "r");
+    if (file == nullptr)
+    {
+        return 0;
+    }
+
+    auto count = std::size_t(0);
+    unsigned long first = 0;
+    while (count < max_count && std::fscanf(file, "%lu", &first) == 1)
+    {
+        auto last = first;
+        auto separator = std::fgetc(file);
+        if (separator == '-')
+        {
+            if (std::fscanf(file, "%lu", &last) != 1) break;
+            separator = std::fgetc(file);
+        }
+
+        for (auto id = first; id <= last && count < max_count; ++id)
+        {
+            ids[count++] = static_cast<std::size_t>(id);
+        }
+
+        if (separator != ',') break;
+    }
+
+    std::fclose(file);
+    return count;
+}
+
+static std::size_t numa_node_ids(std::size_t* ids) noexcept
+{
+    auto count = read_id_list("/sys/devices/system/node/has_memory", ids, max_numa_nodes);
+    if (count == 0)
+    {
+        count = read_id_list("/sys/devices/system/node/online", ids, max_numa_nodes);
+    }
+
+    // node mask of mbind has max_numa_nodes bits, so higher ids of sparse list like "0,64" are skipped
+    auto valid_count = std::size_t(0);
+    for (std::size_t index = 0; index < count; ++index)
+    {
+        if (ids[index] < max_numa_nodes)
+        {
+            ids[valid_count++] = ids[index];
+        }
+    }
+    count = valid_count;
+
+    if (count == 0)
+    {
+        ids[0] = 0;
+        count = 1;
+    }
+    return count;
+}
+
+std::size_t current_numa_node() noexcept
+{
+    unsigned cpu = 0;
+    unsigned node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0 || node >= max_numa_nodes)
+    {
+        return 0;
+    }
+    return static_cast<std::size_t>(node);
+}
+
+// touch pages from CPUs of node, so kernel places them on node by default policy
+static bool touch_from_node(char* memory, std::size_t bytes, std::size_t node, std::size_t page_size) noexcept
+{
+    char path[64];
+    std::snprintf(path, sizeof(path), "/sys/devices/system/node/node%zu/cpulist", node);
+
+    static constexpr auto max_cpus = std::size_t(CPU_SETSIZE);
+    std::size_t cpus[max_cpus];
+    auto const cpu_count = read_id_list(path, cpus, max_cpus);
+
+    cpu_set_t node_cpus;
+    CPU_ZERO(&node_cpus);
+    for (std::size_t index = 0; index < cpu_count; ++index)
+    {
+        CPU_SET(cpus[index], &node_cpus);
+    }
+
+    cpu_set_t old_cpus;
+    auto const is_moved = cpu_count != 0
+        && sched_getaffinity(0, sizeof(old_cpus), &old_cpus) == 0
+        && sched_setaffinity(0, sizeof(node_cpus), &node_cpus) == 0;
+
+    for (std::size_t offset = 0; offset < bytes; offset += page_size)
+    {
+        memory[offset] = 0;
+    }
+
+    if (is_moved)
+    {
+        sched_setaffinity(0, sizeof(old_cpus), &old_cpus);
+    }
+    return is_moved;
+}
+
+static char* map_node_memory(std::size_t bytes, std::size_t node, std::size_t node_count, numa_binding_t& binding) noexcept
+{
+    auto memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED)
+    {
+        return nullptr;
+    }
+
+    binding = numa_binding_t::none;
+    if (node_count > 1)
+    {
+        static constexpr auto mpol_bind = 2;
+        unsigned long mask = 1ul << node;
+        if (syscall(SYS_mbind, memory, bytes, mpol_bind, &mask, max_numa_nodes + 1, 0) == 0)
+        {
+            binding = numa_binding_t::bind;
+        }
+        else if (touch_from_node(static_cast<char*>(memory), bytes, node, static_cast<std::size_t>(sysconf(_SC_PAGESIZE))))
+        {
+            binding = numa_binding_t::first_touch;
+        }
+    }
+    return static_cast<char*>(memory);
+}
+#else
+static std::size_t numa_node_ids(std::size_t* ids) noexcept
+{
+    ids[0] = 0;
+    return 1;
+}
+
+std::size_t current_numa_node() noexcept
+{
+    return 0;
+}
+
+static char* map_node_memory(std::size_t bytes, std::size_t, std::size_t, numa_binding_t& binding) noexcept
+{
+    auto memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    binding = numa_binding_t::none;
+    return memory == MAP_FAILED ? nullptr : static_cast<char*>(memory);
+}
+#endif // __linux__
+
+static void unmap_node_memory(char* memory, std::size_t bytes) noexcept
+{
+    munmap(memory, bytes);
+}
+
+static std::size_t system_page_size() noexcept
+{
+    return static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+}
+#endif // _WIN32
+
+std::size_t numa_node_count() noexcept
+{
+    std::size_t ids[max_numa_nodes];
+    return numa_node_ids(ids);
+}
+
+numa_arenas_t::~numa_arenas_t()
+{
+    close();
+}
+
+bool numa_arenas_t::create(std::size_t bytes_per_node) noexcept
+{
+    close();
+
+    auto const page_size = system_page_size();
+    auto const bytes = (bytes_per_node + page_size - 1) / page_size * page_size;
+    if (bytes == 0)
+    {
+        return false;
+    }
+
+    std::size_t ids[max_numa_nodes];
+    auto const node_count = numa_node_ids(ids);
+
+    for (std::size_t index = 0; index < node_count; ++index)
+    {
+        auto& arena = xxarenas[index];
+        arena.memory = map_node_memory(bytes, ids[index], node_count, arena.binding);
+        if (arena.memory == nullptr)
+        {
+            close();
+            return false;
+        }
+
+        arena.bytes = bytes;
+        arena.node = ids[index];
+        arena.manager = segment_manager_t(arena.memory, bytes);
+
+        if (ids[index] < max_numa_nodes)
+        {
+            xxnode_arenas[ids[index]] = index;
+        }
+        ++xxarena_count;
+    }
+    return true;
+}
+
+void numa_arenas_t::close() noexcept
+{
+    for (std::size_t index = 0; index < xxarena_count; ++index)
+    {
+        auto& arena = xxarenas[index];
+        unmap_node_memory(arena.memory, arena.bytes);
+
+        arena.manager = segment_manager_t(nullptr, 0);
+        arena.memory = nullptr;
+        arena.bytes = 0;
+        arena.node = 0;
+        arena.binding = numa_binding_t::none;
+    }
+
+    for (auto& arena : xxnode_arenas)
+    {
+        arena = 0;
+    }
+    xxarena_count = 0;
+}
+
+std::size_t numa_arenas_t::local_arena() const noexcept
+{
+    auto const node = current_numa_node();
+    return node < max_numa_nodes ? xxnode_arenas[node] : 0;
+}
+
+std::size_t numa_arenas_t::arena_of(void const* memory) const noexcept
+{
+    auto const address = static_cast<char const*>(memory);
+    for (std::size_t index = 0; index < xxarena_count; ++index)
+    {
+        auto const& arena = xxarenas[index];
+        if (address >= arena.memory && address < arena.memory + arena.bytes)
+        {
+            return index;
+        }
+    }
+    return npos;
+}
+
+void* numa_arenas_t::add_segment(std::size_t size) noexcept
+{
+    if (xxarena_count == 0)
+    {
+        return nullptr;
+    }
+
+    // remote arena is still better than failure
+    auto const local = local_arena();
+    for (std::size_t step = 0; step < xxarena_count; ++step)
+    {
+        auto memory = add_segment(size, (local + step) % xxarena_count);
+        if (memory != nullptr)
+        {
+            return memory;
+        }
+    }
+    return nullptr;
+}
+
+void* numa_arenas_t::add_segment(std::size_t size, std::size_t arena) noexcept
+{
+    if (arena >= xxarena_count)
+    {
+        return nullptr;
+    }
+
+    lock(arena);
+    auto memory = xxarenas[arena].manager.add_segment(size);
+    unlock(arena);
+    return memory;
+}
+
+bool numa_arenas_t::extend_segment(void* memory) noexcept
+{
+    auto const arena = arena_of(memory);
+    if (arena == npos)
+    {
+        return false;
+    }
+
+    lock(arena);
+    auto const extended = xxarenas[arena].manager.extend_segment(memory);
+    unlock(arena);
+    return extended;
+}
+
+bool numa_arenas_t::extend_segment(void* memory, std::size_t size) noexcept
+{
+    auto const arena = arena_of(memory);
+    if (arena == npos)
+    {
+        return false;
+    }
+
+    lock(arena);
+    auto const extended = xxarenas[arena].manager.extend_segment(memory, size);
+    unlock(arena);
+    return extended;
+}
+
+bool numa_arenas_t::remove_segment(void* memory) noexcept
+{
+    auto const arena = arena_of(memory);
+    if (arena == npos)
+    {
+        return false;
+    }
+
+    lock(arena);
+    auto const removed = xxarenas[arena].manager.remove_segment(memory);
+    unlock(arena);
+    return removed;
+}
+
+void numa_arenas_t::lock(std::size_t arena) noexcept
+{
+    xxarenas[arena].lock.lock();
+}
+
+void numa_arenas_t::unlock(std::size_t arena) noexcept
+{
+    xxarenas[arena].lock.unlock();
+}
+
+} // namespace eightmory
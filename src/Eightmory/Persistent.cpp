@@ -0,0 +1,151 @@
+#include <Eightmory/Persistent.hpp>
+
+#include <new> // placement new
+
+namespace eightmory
+{
+
+persistent_segment_manager_t::~persistent_segment_manager_t()
+{
+    close();
+}
+
+bool persistent_segment_manager_t::create(char const* path, std::size_t bytes) noexcept
+{
+    close();
+
+    // heap size must be greater than sizeof(segment_t)
+    if (bytes < sizeof(segment_t) || bytes > segment_t::max_size - sizeof(persistent_header_t))
+    {
+        return false;
+    }
+
+    if (!map_file(xxmapping, path, sizeof(persistent_header_t) + bytes))
+    {
+        return false;
+    }
+
+    xxheader = new (xxmapping.memory) persistent_header_t{};
+    xxheader->magic = persistent_header_t::signature;
+    xxheader->version = persistent_header_t::current_version;
+    xxheader->segment_bytes = sizeof(segment_t);
+    xxheader->bytes = bytes;
+    xxheader->root = npos;
+
+    xxmanager = segment_manager_t(xxheader + 1, bytes);
+    xxrecovered = false;
+    return true;
+}
+
+// cut off broken segments to single free segment
+// return 'true' if recovered
+static bool recover_segments(segment_manager_t& manager) noexcept
+{
+    auto const end = reinterpret_cast<char*>(manager.end());
+    for (auto segment = manager.begin(); segment != manager.end(); segment = segment->next())
+    {
+        auto const available = static_cast<std::size_t>(end - reinterpret_cast<char*>(segment->memory()));
+        if (segment->size > available)
+        {
+            segment->size = available;
+            segment->is_used = false;
+            return true;
+        }
+
+        auto const rest = available - segment->size;
+        // rest memory cannot hold any segment
+        if (rest != 0 && rest < sizeof(segment_t))
+        {
+            segment->size = available;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool persistent_segment_manager_t::open(char const* path) noexcept
+{
+    close();
+
+    if (!map_file(xxmapping, path, 0))
+    {
+        return false;
+    }
+
+    auto header = reinterpret_cast<persistent_header_t*>(xxmapping.memory);
+    if
+    (
+        xxmapping.bytes < sizeof(persistent_header_t) + sizeof(segment_t) ||
+        header->magic != persistent_header_t::signature ||
+        header->version != persistent_header_t::current_version ||
+        header->segment_bytes != sizeof(segment_t) ||
+        header->bytes != xxmapping.bytes - sizeof(persistent_header_t)
+    )
+    {
+        unmap(xxmapping);
+        return false;
+    }
+
+    xxheader = header;
+    xxmanager = segment_manager_t::attach(xxheader + 1, static_cast<std::size_t>(xxheader->bytes));
+
+    // process may crash or file may be changed outside, so segments are always validated
+    xxrecovered = recover_segments(xxmanager);
+    if (xxheader->root != npos && xxheader->root >= xxheader->bytes)
+    {
+        xxheader->root = npos;
+        xxrecovered = true;
+    }
+
+    return true;
+}
+
+bool persistent_segment_manager_t::flush() noexcept
+{
+    return sync_mapping(xxmapping);
+}
+
+void persistent_segment_manager_t::close() noexcept
+{
+    if (xxheader != nullptr)
+    {
+        sync_mapping(xxmapping);
+        unmap(xxmapping);
+
+        xxheader = nullptr;
+        xxmanager = segment_manager_t(nullptr, 0);
+    }
+}
+
+std::size_t persistent_segment_manager_t::offset(void const* memory) const noexcept
+{
+    if (memory == nullptr)
+    {
+        return npos;
+    }
+    return static_cast<std::size_t>
+    (
+        reinterpret_cast<char const*>(memory) - reinterpret_cast<char const*>(xxmanager.begin())
+    );
+}
+
+void* persistent_segment_manager_t::memory(std::size_t offset) const noexcept
+{
+    if (offset == npos)
+    {
+        return nullptr;
+    }
+    return reinterpret_cast<char*>(xxmanager.begin()) + offset;
+}
+
+void persistent_segment_manager_t::root(void* memory) noexcept
+{
+    xxheader->root = offset(memory);
+}
+
+void* persistent_segment_manager_t::root() const noexcept
+{
+    return memory(static_cast<std::size_t>(xxheader->root));
+}
+
+} // namespace eightmory
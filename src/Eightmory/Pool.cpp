@@ -0,0 +1,189 @@
+#include <Eightmory/Pool.hpp>
+
+#include <cstdint> // uintptr_t
+
+namespace eightmory
+{
+
+static constexpr std::uint64_t make_head(std::uint32_t index, std::uint64_t tag) noexcept
+{
+    return (tag << 32) | index;
+}
+
+static constexpr std::uint32_t head_index(std::uint64_t head) noexcept
+{
+    return static_cast<std::uint32_t>(head);
+}
+
+static constexpr std::uint64_t head_tag(std::uint64_t head) noexcept
+{
+    return head >> 32;
+}
+
+fixed_pool_t::fixed_pool_t(void* memory, std::size_t bytes, std::size_t block_size, std::size_t batch_size) noexcept
+{
+    auto const address = reinterpret_cast<std::uintptr_t>(memory);
+    auto const aligned = (address + block_align - 1) & ~std::uintptr_t(block_align - 1);
+    auto const slack = static_cast<std::size_t>(aligned - address);
+
+    block_size = (block_size + block_align - 1) & ~(block_align - 1);
+    if (memory == nullptr || block_size == 0 || batch_size == 0 || bytes < slack + block_size)
+    {
+        return;
+    }
+
+    xxblocks = reinterpret_cast<char*>(aligned);
+    xxblock_size = block_size;
+    xxblock_count = (bytes - slack) / block_size;
+    xxbatch_size = batch_size;
+
+    if (xxblock_count >= npos)
+    {
+        xxblock_count = npos - 1;
+    }
+
+    // initial chains are pushed in reverse, so first blocks are allocated first
+    auto const chain_count = (xxblock_count + batch_size - 1) / batch_size;
+    for (auto chain = chain_count; chain-- > 0;)
+    {
+        auto const first = static_cast<std::uint32_t>(chain * batch_size);
+        auto const last = static_cast<std::uint32_t>(chain * batch_size + batch_size < xxblock_count ? chain * batch_size + batch_size - 1 : xxblock_count - 1);
+        for (auto index = first; index < last; ++index)
+        {
+            next_block(index) = index + 1;
+        }
+        next_block(last) = npos;
+        push_chain(first);
+    }
+}
+
+std::uint32_t fixed_pool_t::pop_chain() noexcept
+{
+    auto head = xxhead.load(std::memory_order_acquire);
+    for (;;)
+    {
+        auto const first = head_index(head);
+        if (first == npos)
+        {
+            return npos;
+        }
+
+        // block may be already popped and reused by other thread, then tag has been changed and exchange fails
+        auto const next = next_chain(first).load(std::memory_order_relaxed);
+        if (xxhead.compare_exchange_weak(head, make_head(next, head_tag(head) + 1), std::memory_order_acquire, std::memory_order_acquire))
+        {
+            return first;
+        }
+    }
+}
+
+void fixed_pool_t::push_chain(std::uint32_t first) noexcept
+{
+    auto head = xxhead.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        next_chain(first).store(head_index(head), std::memory_order_relaxed);
+        if (xxhead.compare_exchange_weak(head, make_head(first, head_tag(head) + 1), std::memory_order_release, std::memory_order_relaxed))
+        {
+            return;
+        }
+    }
+}
+
+void* fixed_pool_t::allocate() noexcept
+{
+    auto const first = pop_chain();
+    if (first == npos)
+    {
+        return nullptr;
+    }
+
+    auto const rest = next_block(first);
+    if (rest != npos)
+    {
+        push_chain(rest);
+    }
+    return block(first);
+}
+
+void fixed_pool_t::deallocate(void* memory) noexcept
+{
+    auto const first = index(memory);
+    next_block(first) = npos;
+    push_chain(first);
+}
+
+fixed_pool_cache_t::~fixed_pool_cache_t()
+{
+    flush();
+}
+
+void* fixed_pool_cache_t::allocate() noexcept
+{
+    if (xxfirst == fixed_pool_t::npos)
+    {
+        xxfirst = xxpool.pop_chain();
+        if (xxfirst == fixed_pool_t::npos)
+        {
+            return nullptr;
+        }
+
+        xxcount = 0;
+        for (auto index = xxfirst; index != fixed_pool_t::npos; index = xxpool.next_block(index))
+        {
+            ++xxcount;
+        }
+    }
+
+    auto const first = xxfirst;
+    xxfirst = xxpool.next_block(first);
+    --xxcount;
+    return xxpool.block(first);
+}
+
+void fixed_pool_cache_t::deallocate(void* memory) noexcept
+{
+    auto const first = xxpool.index(memory);
+    xxpool.next_block(first) = xxfirst;
+    xxfirst = first;
+    ++xxcount;
+
+    // keep recently freed, cache-hot batch on top for next allocations, return colder blocks below
+    if (xxcount >= 2 * xxpool.batch_size())
+    {
+        release_batch();
+    }
+}
+
+void fixed_pool_cache_t::release_batch() noexcept
+{
+    auto last = xxfirst;
+    for (std::size_t count = 1; count < xxpool.batch_size(); ++count)
+    {
+        last = xxpool.next_block(last);
+    }
+
+    auto const rest = xxpool.next_block(last);
+    xxpool.next_block(last) = fixed_pool_t::npos;
+    xxcount = xxpool.batch_size();
+
+    xxpool.push_chain(rest);
+}
+
+void fixed_pool_cache_t::flush() noexcept
+{
+    if (xxcount > xxpool.batch_size())
+    {
+        release_batch();
+    }
+
+    if (xxfirst != fixed_pool_t::npos)
+    {
+        xxpool.push_chain(xxfirst);
+    }
+
+    xxfirst = fixed_pool_t::npos;
+    xxcount = 0;
+}
+
+} // namespace eightmory
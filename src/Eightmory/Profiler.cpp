@@ -0,0 +1,270 @@
+#include <Eightmory/Profiler.hpp>
+
+#include <cmath> // log
+#include <new> // bad_alloc
+#include <utility> // pair
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif // NOMINMAX
+#include <windows.h> // CaptureStackBackTrace
+#elif defined(__GLIBC__) || defined(__APPLE__)
+#include <execinfo.h> // backtrace
+#endif
+
+namespace eightmory
+{
+
+// frame of profiler itself is skipped
+static constexpr auto skip_frames = std::size_t(1);
+
+static std::size_t capture_stack(void** frames, std::size_t max_depth) noexcept
+{
+    void* stack[heap_profiler_t::max_depth + skip_frames];
+    auto depth = std::size_t(0);
+#if defined(_WIN32)
+    depth = CaptureStackBackTrace(0, static_cast<DWORD>(max_depth + skip_frames), stack, nullptr);
+#elif defined(__GLIBC__) || defined(__APPLE__)
+    depth = static_cast<std::size_t>(backtrace(stack, static_cast<int>(max_depth + skip_frames)));
+#endif
+    if (depth <= skip_frames)
+    {
+        return 0;
+    }
+
+    depth -= skip_frames;
+    for (std::size_t index = 0; index < depth; ++index)
+    {
+        frames[index] = stack[skip_frames + index];
+    }
+    return depth;
+}
+
+heap_profiler_t::heap_profiler_t(std::size_t sample_period, std::uint64_t seed) noexcept
+    : xxrandom(seed == 0 ? 1 : seed)
+{
+    set_sample_period(sample_period);
+}
+
+void heap_profiler_t::set_sample_period(std::size_t sample_period) noexcept
+{
+    xxsample_period = sample_period;
+    xxbytes_until_sample = next_sample_distance();
+}
+
+void heap_profiler_t::reset() noexcept
+{
+    xxbuckets.clear();
+    xxbucket_index.clear();
+    xxsamples.clear();
+    for (auto& count : xxfilter) count = 0;
+    xxbytes_until_sample = next_sample_distance();
+}
+
+std::size_t heap_profiler_t::next_sample_distance() noexcept
+{
+    if (xxsample_period == 0)
+    {
+        return std::size_t(-1);
+    }
+
+    // xorshift64
+    xxrandom ^= xxrandom << 13;
+    xxrandom ^= xxrandom >> 7;
+    xxrandom ^= xxrandom << 17;
+
+    // uniform in (0, 1]
+    auto const uniform = (double(xxrandom >> 11) + 1.0) / 9007199254740992.0;
+    auto const distance = -std::log(uniform) * double(xxsample_period);
+    return static_cast<std::size_t>(distance) + 1;
+}
+
+std::size_t heap_profiler_t::find_bucket(void* const* frames, std::size_t depth) noexcept
+{
+    // FNV-1a over frames
+    auto hash = std::uint64_t(0xCBF29CE484222325);
+    for (std::size_t index = 0; index < depth; ++index)
+    {
+        hash = (hash ^ reinterpret_cast<std::uintptr_t>(frames[index])) * 0x100000001B3;
+    }
+
+    // resolve rare hash collisions by probing next hash
+    for (auto key = hash;; ++key)
+    {
+        auto const it = xxbucket_index.find(key);
+        if (it == xxbucket_index.end())
+        {
+            bucket_t bucket;
+            bucket.hash = key;
+            bucket.depth = depth;
+            for (std::size_t index = 0; index < depth; ++index)
+            {
+                bucket.frames[index] = frames[index];
+            }
+
+            // bucket is added with its index or not at all
+            try
+            {
+                xxbucket_index.emplace(key, xxbuckets.size());
+                xxbuckets.push_back(bucket);
+            }
+            catch (std::bad_alloc const&)
+            {
+                xxbucket_index.erase(key);
+                return npos;
+            }
+            return xxbuckets.size() - 1;
+        }
+
+        auto const& bucket = xxbuckets[it->second];
+        auto is_same = bucket.depth == depth;
+        for (std::size_t index = 0; is_same && index < depth; ++index)
+        {
+            is_same = bucket.frames[index] == frames[index];
+        }
+        if (is_same)
+        {
+            return it->second;
+        }
+    }
+}
+
+void heap_profiler_t::sample(void* memory, std::size_t size, std::uint32_t) noexcept
+{
+    // rest of distance is not carried over, as in tcmalloc, sampling stays unbiased because of memorylessness
+    xxbytes_until_sample = next_sample_distance();
+
+    void* frames[max_depth];
+    auto const depth = capture_stack(frames, max_depth);
+
+    // sample is dropped, if profiler is out of memory
+    auto const index = find_bucket(frames, depth);
+    if (index == npos)
+    {
+        return;
+    }
+
+    auto inserted = std::pair(xxsamples.end(), false);
+    try
+    {
+        inserted = xxsamples.try_emplace(memory);
+    }
+    catch (std::bad_alloc const&)
+    {
+        return;
+    }
+
+    auto const [it, is_inserted] = inserted;
+
+    // memory was released without free hook, like by reset of heap, so old sample is retired
+    if (!is_inserted)
+    {
+        auto& retired = xxbuckets[it->second.bucket];
+        --retired.inuse_count;
+        retired.inuse_bytes -= it->second.size;
+    }
+    it->second = sample_t{index, size};
+    xxfilter[filter_index(memory)] += is_inserted;
+
+    auto& bucket = xxbuckets[index];
+    ++bucket.inuse_count;
+    bucket.inuse_bytes += size;
+    ++bucket.alloc_count;
+    bucket.alloc_bytes += size;
+}
+
+void heap_profiler_t::release(void* memory) noexcept
+{
+    auto const it = xxsamples.find(memory);
+    if (it == xxsamples.end())
+    {
+        return;
+    }
+
+    auto& bucket = xxbuckets[it->second.bucket];
+    --bucket.inuse_count;
+    bucket.inuse_bytes -= it->second.size;
+
+    --xxfilter[filter_index(memory)];
+    xxsamples.erase(it);
+}
+
+void heap_profiler_t::resize(void* memory, std::size_t size) noexcept
+{
+    auto const it = xxsamples.find(memory);
+    if (it == xxsamples.end())
+    {
+        return;
+    }
+
+    auto& bucket = xxbuckets[it->second.bucket];
+    bucket.inuse_bytes += size - it->second.size;
+    if (size > it->second.size)
+    {
+        bucket.alloc_bytes += size - it->second.size;
+    }
+    it->second.size = size;
+}
+
+bool heap_profiler_t::write_heap_profile(std::FILE* file) const noexcept
+{
+    bucket_t total;
+    for (auto const& bucket : xxbuckets)
+    {
+        total.inuse_count += bucket.inuse_count;
+        total.inuse_bytes += bucket.inuse_bytes;
+        total.alloc_count += bucket.alloc_count;
+        total.alloc_bytes += bucket.alloc_bytes;
+    }
+
+    auto success = std::fprintf
+    (
+        file, "heap profile: %6zu: %8zu [%6zu: %8zu] @ heap_v2/%zu\n",
+        total.inuse_count, total.inuse_bytes, total.alloc_count, total.alloc_bytes, xxsample_period
+    ) > 0;
+
+    for (auto const& bucket : xxbuckets)
+    {
+        success &= std::fprintf
+        (
+            file, "%6zu: %8zu [%6zu: %8zu] @",
+            bucket.inuse_count, bucket.inuse_bytes, bucket.alloc_count, bucket.alloc_bytes
+        ) > 0;
+
+        for (std::size_t index = 0; index < bucket.depth; ++index)
+        {
+            success &= std::fprintf(file, " 0x%llx", static_cast<unsigned long long>(reinterpret_cast<std::uintptr_t>(bucket.frames[index]))) > 0;
+        }
+        success &= std::fputc('\n', file) != EOF;
+    }
+
+    // pprof needs mappings to symbolize addresses
+    success &= std::fputs("\nMAPPED_LIBRARIES:\n", file) != EOF;
+#ifdef __linux__
+    if (auto maps = std::fopen("/proc/self/maps", "r"))
+    {
+        char buffer[4096];
+        for (std::size_t count; (count = std::fread(buffer, 1, sizeof(buffer), maps)) != 0;)
+        {
+            success &= std::fwrite(buffer, 1, count, file) == count;
+        }
+        std::fclose(maps);
+    }
+#endif // __linux__
+    return success;
+}
+
+bool heap_profiler_t::write_heap_profile(char const* path) const noexcept
+{
+    auto file = std::fopen(path, "w");
+    if (file == nullptr)
+    {
+        return false;
+    }
+
+    auto const success = write_heap_profile(file);
+    return std::fclose(file) == 0 && success;
+}
+
+} // namespace eightmory
@@ -0,0 +1,210 @@
+#include <Eightmory/Shared.hpp>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif // NOMINMAX
+#include <windows.h> // GetCurrentProcessId, OpenProcess
+#else
+#include <signal.h> // kill
+#include <unistd.h> // getpid
+#include <cerrno> // errno
+#endif // _WIN32
+
+#include <new> // placement new
+
+namespace eightmory
+{
+
+static std::uint32_t current_process_id() noexcept
+{
+#ifdef _WIN32
+    return static_cast<std::uint32_t>(GetCurrentProcessId());
+#else
+    return static_cast<std::uint32_t>(getpid());
+#endif // _WIN32
+}
+
+// process without permission to check is considered alive
+// return 'true' if process exists
+static bool is_process_alive(std::uint32_t id) noexcept
+{
+#ifdef _WIN32
+    auto process = OpenProcess(SYNCHRONIZE, FALSE, static_cast<DWORD>(id));
+    if (process == nullptr)
+    {
+        return GetLastError() == ERROR_ACCESS_DENIED;
+    }
+
+    auto const is_alive = WaitForSingleObject(process, 0) == WAIT_TIMEOUT;
+    CloseHandle(process);
+    return is_alive;
+#else
+    return kill(static_cast<pid_t>(id), 0) == 0 || errno == EPERM;
+#endif // _WIN32
+}
+
+shared_segment_manager_t::~shared_segment_manager_t()
+{
+    close();
+}
+
+bool shared_segment_manager_t::create(char const* name, std::size_t bytes) noexcept
+{
+    close();
+
+    // heap size must be greater than sizeof(segment_t)
+    if (bytes < sizeof(segment_t) || bytes > segment_t::max_size - sizeof(shared_header_t))
+    {
+        return false;
+    }
+
+    if (!map_shared(xxmapping, name, sizeof(shared_header_t) + bytes))
+    {
+        return false;
+    }
+
+    auto header = new (xxmapping.memory) shared_header_t{};
+    header->version = shared_header_t::current_version;
+    header->segment_bytes = sizeof(segment_t);
+    header->bytes = bytes;
+
+    xxheader = header;
+    xxmanager = segment_manager_t(xxheader + 1, bytes);
+    xxmanager.disable_segment_tracking();
+
+    // other processes may open memory only after initialization
+    header->magic.store(shared_header_t::signature, std::memory_order_release);
+    return true;
+}
+
+bool shared_segment_manager_t::open(char const* name) noexcept
+{
+    close();
+
+    if (!map_shared(xxmapping, name, 0))
+    {
+        return false;
+    }
+
+    auto header = reinterpret_cast<shared_header_t*>(xxmapping.memory);
+    if
+    (
+        xxmapping.bytes < sizeof(shared_header_t) + sizeof(segment_t) ||
+        header->magic.load(std::memory_order_acquire) != shared_header_t::signature ||
+        header->version != shared_header_t::current_version ||
+        header->segment_bytes != sizeof(segment_t) ||
+        header->bytes > xxmapping.bytes - sizeof(shared_header_t)
+    )
+    {
+        unmap(xxmapping);
+        return false;
+    }
+
+    xxheader = header;
+    xxmanager = segment_manager_t::attach(xxheader + 1, static_cast<std::size_t>(xxheader->bytes));
+    xxmanager.disable_segment_tracking();
+    return true;
+}
+
+void shared_segment_manager_t::close() noexcept
+{
+    if (xxheader != nullptr)
+    {
+        unmap(xxmapping);
+
+        xxheader = nullptr;
+        xxmanager = segment_manager_t(nullptr, 0);
+    }
+}
+
+bool shared_segment_manager_t::remove(char const* name) noexcept
+{
+    return unlink_shared(name);
+}
+
+void* shared_segment_manager_t::add_segment(std::size_t size) noexcept
+{
+    lock();
+    auto memory = xxmanager.add_segment(size);
+    unlock();
+    return memory;
+}
+
+bool shared_segment_manager_t::extend_segment(void* memory) noexcept
+{
+    lock();
+    auto const extended = xxmanager.extend_segment(memory);
+    unlock();
+    return extended;
+}
+
+bool shared_segment_manager_t::extend_segment(void* memory, std::size_t size) noexcept
+{
+    lock();
+    auto const extended = xxmanager.extend_segment(memory, size);
+    unlock();
+    return extended;
+}
+
+bool shared_segment_manager_t::remove_segment(void* memory) noexcept
+{
+    lock();
+    auto const removed = xxmanager.remove_segment(memory);
+    unlock();
+    return removed;
+}
+
+std::size_t shared_segment_manager_t::offset(void const* memory) const noexcept
+{
+    if (memory == nullptr)
+    {
+        return npos;
+    }
+    return static_cast<std::size_t>
+    (
+        reinterpret_cast<char const*>(memory) - reinterpret_cast<char const*>(xxmanager.begin())
+    );
+}
+
+void* shared_segment_manager_t::memory(std::size_t offset) const noexcept
+{
+    if (offset == npos)
+    {
+        return nullptr;
+    }
+    return reinterpret_cast<char*>(xxmanager.begin()) + offset;
+}
+
+void shared_segment_manager_t::lock() noexcept
+{
+    auto& lock = xxheader->lock;
+    auto const self = current_process_id();
+    while (!lock.try_lock(self))
+    {
+        if (lock.wait(1024))
+        {
+            continue;
+        }
+
+        // owner process may die while holding lock, exited but not waited process is still alive
+        auto const owner = lock.owner();
+        if (owner != 0 && owner != self && !is_process_alive(owner) && lock.take_over(owner, self))
+        {
+            xxheader->dead_owner_count.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+}
+
+void shared_segment_manager_t::unlock() noexcept
+{
+    xxheader->lock.unlock();
+}
+
+std::uint32_t shared_segment_manager_t::dead_owner_count() const noexcept
+{
+    return xxheader != nullptr ? xxheader->dead_owner_count.load(std::memory_order_relaxed) : 0;
+}
+
+} // namespace eightmory
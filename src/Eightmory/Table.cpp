@@ -0,0 +1,187 @@
+#include <Eightmory/Table.hpp>
+#include <Eightmory/Core.hpp>
+
+#include <algorithm> // copy, copy_backward, lower_bound
+
+namespace eightmory
+{
+
+table_segment_manager_t::table_segment_manager_t(void* memory, std::size_t bytes, segment_entry_t* entries, std::size_t capacity) noexcept
+{
+    // whole memory is described by single free entry
+    if (bytes > 0 && bytes <= segment_t::max_size && capacity > 0)
+    {
+        xxmemory = reinterpret_cast<char*>(memory);
+        xxbytes = bytes;
+
+        xxentries = entries;
+        xxcapacity = capacity;
+
+        xxentries[0].offset = 0;
+        xxentries[0].size = bytes;
+        xxentries[0].is_used = false;
+        xxcount = 1;
+    }
+}
+
+bool table_segment_manager_t::insert(std::size_t index, segment_entry_t entry) noexcept
+{
+    if (xxcount == xxcapacity)
+    {
+        return false;
+    }
+
+    std::copy_backward(xxentries + index, xxentries + xxcount, xxentries + xxcount + 1);
+    xxentries[index] = entry;
+    ++xxcount;
+    return true;
+}
+
+void table_segment_manager_t::erase(std::size_t index) noexcept
+{
+    std::copy(xxentries + index + 1, xxentries + xxcount, xxentries + index);
+    --xxcount;
+}
+
+void* table_segment_manager_t::add_segment(std::size_t size, std::size_t align) noexcept
+{
+    if (size == 0)
+    {
+        size = 1;
+    }
+
+    auto const base = reinterpret_cast<std::size_t>(xxmemory);
+    for (std::size_t index = 0; index < xxcount; ++index)
+    {
+        auto& entry = xxentries[index];
+        if (entry.is_used || entry.size < size)
+        {
+            continue;
+        }
+
+        auto const padding = align_up(base + entry.offset, align) - (base + entry.offset);
+        if (padding > entry.size - size)
+        {
+            continue;
+        }
+
+        // lhs padding must be kept as free entry
+        if (padding > 0)
+        {
+            if (!insert(index, segment_entry_t{entry.offset, padding, false}))
+            {
+                continue;
+            }
+
+            ++index;
+            xxentries[index].offset += padding;
+            xxentries[index].size -= padding;
+        }
+
+        auto& created = xxentries[index];
+        created.is_used = true;
+
+        // rhs rest stay in used segment when table is full
+        if (created.size > size && insert(index + 1, segment_entry_t{created.offset + size, created.size - size, false}))
+        {
+            xxentries[index].size = size;
+        }
+
+        return xxmemory + xxentries[index].offset;
+    }
+    return nullptr;
+}
+
+segment_entry_t* table_segment_manager_t::find_segment(void const* memory) const noexcept
+{
+    auto const address = reinterpret_cast<char const*>(memory);
+    if (address < xxmemory || address >= xxmemory + xxbytes)
+    {
+        return nullptr;
+    }
+
+    auto const offset = static_cast<std::size_t>(address - xxmemory);
+    auto entry = std::lower_bound
+    (
+        begin(), end(), offset,
+        [](segment_entry_t const& entry, std::size_t offset) { return entry.offset < offset; }
+    );
+
+    if (entry == end() || entry->offset != offset || !entry->is_used)
+    {
+        return nullptr;
+    }
+    return entry;
+}
+
+bool table_segment_manager_t::extend_segment(void* memory) noexcept
+{
+    auto entry = find_segment(memory);
+    if (entry == nullptr)
+    {
+        return false;
+    }
+
+    auto rhs = entry + 1;
+    if (rhs == end() || rhs->is_used)
+    {
+        return false;
+    }
+
+    entry->size += rhs->size;
+    erase(static_cast<std::size_t>(rhs - begin()));
+    return true;
+}
+
+bool table_segment_manager_t::extend_segment(void* memory, std::size_t size) noexcept
+{
+    auto entry = find_segment(memory);
+    if (entry == nullptr)
+    {
+        return false;
+    }
+
+    auto rhs = entry + 1;
+    if (rhs == end() || rhs->is_used || rhs->size < size)
+    {
+        return false;
+    }
+
+    entry->size += size;
+    rhs->offset += size;
+    rhs->size -= size;
+
+    if (rhs->size == 0)
+    {
+        erase(static_cast<std::size_t>(rhs - begin()));
+    }
+    return true;
+}
+
+bool table_segment_manager_t::remove_segment(void* memory) noexcept
+{
+    auto entry = find_segment(memory);
+    if (entry == nullptr)
+    {
+        return false;
+    }
+
+    auto index = static_cast<std::size_t>(entry - begin());
+    entry->is_used = false;
+
+    // keep free entries separated by used ones
+    if (index + 1 < xxcount && !xxentries[index + 1].is_used)
+    {
+        xxentries[index].size += xxentries[index + 1].size;
+        erase(index + 1);
+    }
+
+    if (index > 0 && !xxentries[index - 1].is_used)
+    {
+        xxentries[index - 1].size += xxentries[index].size;
+        erase(index);
+    }
+    return true;
+}
+
+} // namespace eightmory
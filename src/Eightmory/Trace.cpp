@@ -0,0 +1,127 @@
+#include <Eightmory/Trace.hpp>
+
+#include <cstring> // memcpy, memcmp
+
+#include "Endian.hpp" // store_le, load_le
+
+namespace eightmory
+{
+
+static constexpr auto success_bit = std::uint8_t(0x80);
+
+trace_writer_t::~trace_writer_t()
+{
+    close();
+}
+
+bool trace_writer_t::open(char const* path, std::size_t segment_bytes, std::size_t bytes) noexcept
+{
+    close();
+
+    xxfile = std::fopen(path, "wb");
+    if (xxfile == nullptr)
+    {
+        return false;
+    }
+
+    unsigned char header[trace_header_t::header_bytes] = {};
+    std::memcpy(header, trace_header_t::magic, sizeof(trace_header_t::magic));
+    store_le(header + 8, trace_header_t::current_version, 4);
+    store_le(header + 12, segment_bytes, 4);
+    store_le(header + 16, bytes, 8);
+
+    xxis_failed = std::fwrite(header, sizeof(header), 1, xxfile) != 1;
+    return !xxis_failed;
+}
+
+bool trace_writer_t::write(trace_record_t const& record) noexcept
+{
+    if (xxfile == nullptr)
+    {
+        return false;
+    }
+
+    unsigned char bytes[trace_header_t::record_bytes];
+    bytes[0] = static_cast<std::uint8_t>(record.op) | (record.is_success ? success_bit : 0);
+    store_le(bytes + 1, record.size, 8);
+    store_le(bytes + 9, record.offset, 8);
+
+    if (std::fwrite(bytes, sizeof(bytes), 1, xxfile) != 1)
+    {
+        xxis_failed = true;
+        return false;
+    }
+    return true;
+}
+
+bool trace_writer_t::close() noexcept
+{
+    if (xxfile == nullptr)
+    {
+        return false;
+    }
+
+    auto const success = !xxis_failed && std::fclose(xxfile) == 0;
+    xxfile = nullptr;
+    return success;
+}
+
+trace_reader_t::~trace_reader_t()
+{
+    close();
+}
+
+bool trace_reader_t::open(char const* path) noexcept
+{
+    close();
+
+    xxfile = std::fopen(path, "rb");
+    if (xxfile == nullptr)
+    {
+        return false;
+    }
+
+    unsigned char header[trace_header_t::header_bytes];
+    if
+    (
+        std::fread(header, sizeof(header), 1, xxfile) != 1 ||
+        std::memcmp(header, trace_header_t::magic, sizeof(trace_header_t::magic)) != 0 ||
+        load_le(header + 8, 4) != trace_header_t::current_version
+    )
+    {
+        close();
+        return false;
+    }
+
+    xxheader.version = static_cast<std::uint32_t>(load_le(header + 8, 4));
+    xxheader.segment_bytes = static_cast<std::uint32_t>(load_le(header + 12, 4));
+    xxheader.bytes = load_le(header + 16, 8);
+    return true;
+}
+
+bool trace_reader_t::read(trace_record_t& record) noexcept
+{
+    unsigned char bytes[trace_header_t::record_bytes];
+    if (xxfile == nullptr || std::fread(bytes, sizeof(bytes), 1, xxfile) != 1)
+    {
+        return false;
+    }
+
+    record.op = static_cast<trace_op_t>(bytes[0] & ~success_bit);
+    record.is_success = (bytes[0] & success_bit) != 0;
+    record.size = static_cast<std::size_t>(load_le(bytes + 1, 8));
+    record.offset = static_cast<std::size_t>(load_le(bytes + 9, 8));
+    return true;
+}
+
+void trace_reader_t::close() noexcept
+{
+    if (xxfile != nullptr)
+    {
+        std::fclose(xxfile);
+        xxfile = nullptr;
+    }
+    xxheader = trace_header_t{};
+}
+
+} // namespace eightmory
@@ -0,0 +1,45 @@
+#include <Eightmory/Zeroed.hpp>
+
+#include <cstring> // memset
+#include <cstdint> // uintptr_t
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h> // _mm_stream_si128, _mm_sfence
+#define EIGHTMORY_HAS_STREAM_STORES
+#endif
+
+namespace eightmory
+{
+
+void clear_memory(void* memory, std::size_t bytes) noexcept
+{
+#ifdef EIGHTMORY_HAS_STREAM_STORES
+    if (bytes >= non_temporal_clear_bytes)
+    {
+        auto address = static_cast<char*>(memory);
+
+        // unaligned head
+        auto const head = (16 - reinterpret_cast<std::uintptr_t>(address) % 16) % 16;
+        std::memset(address, 0, head);
+        address += head;
+        bytes -= head;
+
+        auto const zero = _mm_setzero_si128();
+        auto const blocks = bytes / 64;
+        for (std::size_t block = 0; block < blocks; ++block, address += 64)
+        {
+            _mm_stream_si128(reinterpret_cast<__m128i*>(address), zero);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(address + 16), zero);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(address + 32), zero);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(address + 48), zero);
+        }
+        _mm_sfence();
+
+        std::memset(address, 0, bytes % 64);
+        return;
+    }
+#endif // EIGHTMORY_HAS_STREAM_STORES
+    std::memset(memory, 0, bytes);
+}
+
+} // namespace eightmory
@@ -4,4 +4,13 @@
 #include <Eightmory/Core.hpp>
 #include <Eightest/Core.hpp>
 
+#include <cstddef> // size_t
+
+// bytes of debug bookkeeping in each manager
+#ifdef EIGHTMORY_DEBUG
+inline constexpr auto debug_manager_bytes = sizeof(eightmory::segment_starts_t);
+#else
+inline constexpr auto debug_manager_bytes = std::size_t(0);
+#endif // EIGHTMORY_DEBUG
+
 #endif // EIGHTMORY_TESTING_BASE_HPP
@@ -0,0 +1,103 @@
+#include <EightmoryTestingBase.hpp>
+
+#include <Eightmory/Cache.hpp>
+#include <Eightmory/Pool.hpp>
+
+#include <cstdint> // uintptr_t
+
+using eightmory::segment_t;
+using eightmory::segment_manager_t;
+using eightmory::compact_segment_manager_t;
+
+using eightmory::cache_line_bytes;
+using eightmory::add_aligned_segment;
+using eightmory::remove_aligned_segment;
+using eightmory::add_isolated_segment;
+using eightmory::remove_isolated_segment;
+using eightmory::slab_colouring_t;
+using eightmory::fixed_pool_t;
+
+TEST_SPACE()
+{
+
+std::uintptr_t line(void const* memory) noexcept
+{
+    return reinterpret_cast<std::uintptr_t>(memory) / cache_line_bytes;
+}
+
+} // TEST_SPACE
+
+TEST(TestCache, TestAligned)
+{
+    alignas(64) char memory[1024];
+    auto manager = compact_segment_manager_t(memory, sizeof(memory));
+
+    auto aligned = add_aligned_segment(manager, 24, 128);
+    ASSERT("add_aligned_segment", aligned != nullptr);
+    EXPECT("add_aligned_segment.align", reinterpret_cast<std::uintptr_t>(aligned) % 128 == 0);
+
+    auto shifted = add_aligned_segment(manager, 24, 64, 16);
+    ASSERT("add_aligned_segment.offset", shifted != nullptr);
+    EXPECT("add_aligned_segment.offset.align", reinterpret_cast<std::uintptr_t>(shifted) % 64 == 16);
+
+    EXPECT("remove_aligned_segment", remove_aligned_segment(manager, aligned) && remove_aligned_segment(manager, shifted));
+    EXPECT("remove_aligned_segment.nullptr", !remove_aligned_segment(manager, nullptr));
+
+    auto whole = manager.add_segment(sizeof(memory) - sizeof(eightmory::compact_segment_t));
+    EXPECT("manager.add_segment.whole", whole != nullptr);
+}
+
+TEST(TestCache, TestIsolated)
+{
+    char memory[2048];
+    auto manager = segment_manager_t(memory, sizeof(memory));
+
+    // hot counters of neighbour threads
+    auto lhs = static_cast<char*>(manager.add_segment(8));
+    auto counter = static_cast<char*>(add_isolated_segment(manager, 8));
+    auto rhs = static_cast<char*>(manager.add_segment(8));
+    ASSERT("add_isolated_segment", lhs != nullptr && counter != nullptr && rhs != nullptr);
+
+    EXPECT("add_isolated_segment.align", reinterpret_cast<std::uintptr_t>(counter) % cache_line_bytes == 0);
+    EXPECT("add_isolated_segment.lhs", line(lhs + 7) < line(counter));
+    EXPECT("add_isolated_segment.rhs", line(segment_t::segment(rhs)) > line(counter) && line(rhs) > line(counter));
+
+    // object of several lines owns all of them
+    auto big = static_cast<char*>(add_isolated_segment(manager, 100));
+    auto after = static_cast<char*>(manager.add_segment(8));
+    ASSERT("add_isolated_segment.big", big != nullptr && after != nullptr);
+    EXPECT("add_isolated_segment.big.rhs", line(segment_t::segment(after)) > line(big + 99));
+
+    EXPECT("remove_isolated_segment", remove_isolated_segment(manager, counter) && remove_isolated_segment(manager, big));
+}
+
+TEST(TestCache, TestColouring)
+{
+    alignas(64) char memory[8192];
+    auto manager = segment_manager_t(memory, sizeof(memory));
+    auto colouring = slab_colouring_t(manager, 3);
+
+    void* slabs[6] = {};
+    for (auto& slab : slabs)
+    {
+        slab = colouring.add_slab(512);
+        ASSERT("colouring.add_slab", slab != nullptr);
+    }
+
+    // slab starts cycle over 4 lines modulo colour span
+    auto const span = colouring.colour_count() * cache_line_bytes;
+    auto colour = [span](void* slab) { return reinterpret_cast<std::uintptr_t>(slab) % span / cache_line_bytes; };
+
+    EXPECT("colouring.colour", colour(slabs[0]) == 0 && colour(slabs[1]) == 1 && colour(slabs[2]) == 2 && colour(slabs[3]) == 3);
+    EXPECT("colouring.cycle", colour(slabs[4]) == colour(slabs[0]) && colour(slabs[5]) == colour(slabs[1]));
+    EXPECT("colouring.colour_count", colouring.colour_count() == 4 && colouring.next_colour() == 2);
+
+    // slab as memory of pool with cache line blocks
+    auto pool = fixed_pool_t(slabs[1], 512, cache_line_bytes);
+    EXPECT("colouring.pool", pool.block_count() == 8 && line(pool.block(0)) != line(pool.block(1)));
+
+    for (auto slab : slabs)
+    {
+        EXPECT("colouring.remove_slab", colouring.remove_slab(slab));
+    }
+}
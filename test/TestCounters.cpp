@@ -0,0 +1,52 @@
+#include <EightmoryTestingBase.hpp>
+
+#include <Eightmory/Counters.hpp>
+
+using eightmory::segment_manager_t;
+
+using eightmory::perf_counter_t;
+using eightmory::perf_sample_t;
+using eightmory::perf_counters_t;
+
+TEST(TestCounters, TestClosedCounters)
+{
+    perf_counters_t counters;
+    EXPECT("counters.is_open", counters.is_open() == false);
+    EXPECT("counters.start", counters.start() == false);
+    EXPECT("counters.stop", counters.stop() == false);
+
+    perf_sample_t sample;
+    EXPECT("counters.read", counters.read(sample) == false);
+    EXPECT("sample.has", !sample.has(perf_counter_t::cycles) && !sample.has(perf_counter_t::branch_misses));
+    EXPECT("sample.per_operation", sample.per_operation(perf_counter_t::instructions, 10) == 0.0);
+}
+
+TEST(TestCounters, TestManagerCounters)
+{
+    perf_counters_t counters;
+    if (!counters.open())
+    {
+        return; // no permissions or not Linux
+    }
+
+    char memory[1024];
+    auto manager = segment_manager_t(memory, sizeof(memory));
+
+    ASSERT("counters.start", counters.start() == true);
+    for (int index = 0; index < 16; ++index)
+    {
+        manager.remove_segment(manager.add_segment(32));
+    }
+    ASSERT("counters.stop", counters.stop() == true);
+
+    perf_sample_t sample;
+    ASSERT("counters.read", counters.read(sample) == true);
+    if (sample.has(perf_counter_t::instructions))
+    {
+        EXPECT("sample.instructions", sample.value(perf_counter_t::instructions) > 0);
+        EXPECT("sample.per_operation", sample.per_operation(perf_counter_t::instructions, 32) > 0.0);
+    }
+
+    counters.close();
+    EXPECT("counters.close", counters.is_open() == false);
+}
@@ -0,0 +1,73 @@
+#include <EightmoryTestingBase.hpp>
+
+#include <Eightmory/Dump.hpp>
+
+#include <cstdio> // remove
+#include <vector> // vector
+
+using eightmory::segment_t;
+using eightmory::segment_manager_t;
+using eightmory::compact_segment_manager_t;
+
+using eightmory::segment_info_t;
+using eightmory::segment_dump_header_t;
+using eightmory::segment_dump_reader_t;
+
+using eightmory::walk_segments;
+using eightmory::dump_segments;
+
+static const char* dump_path = "EightmoryTestDump.bin";
+
+TEST(TestDump, TestWalk)
+{
+    // [8 + 8] (8 + 4) [8 + 4] (8 + 8)
+    char memory[56];
+    auto manager = segment_manager_t(memory, sizeof(memory));
+
+    auto eight_size_memory = manager.add_segment(8);
+    auto four_size_memory = manager.add_segment(4);
+    auto other_memory = manager.add_segment(4);
+    ASSERT("manager.add_segment", eight_size_memory != nullptr && four_size_memory != nullptr && other_memory != nullptr);
+    manager.remove_segment(four_size_memory);
+
+    std::vector<segment_info_t> segments;
+    auto const is_valid = walk_segments(manager, [&segments](segment_info_t const& info) { segments.push_back(info); });
+
+    EXPECT("walk_segments.is_valid", is_valid == true);
+    ASSERT("walk_segments.count", segments.size() == 4);
+    EXPECT("walk_segments.offset", segments[0].offset == 0 && segments[1].offset == 16 && segments[2].offset == 28 && segments[3].offset == 40);
+    EXPECT("walk_segments.size", segments[0].size == 8 && segments[1].size == 4 && segments[2].size == 4 && segments[3].size == 8);
+    EXPECT("walk_segments.is_used", segments[0].is_used && !segments[1].is_used && segments[2].is_used && !segments[3].is_used);
+
+    // broken size of last segment
+    segment_t::segment(other_memory)->next()->size = 64;
+
+    auto count = std::size_t(0);
+    EXPECT("walk_segments.broken", walk_segments(manager, [&count](segment_info_t const&) { ++count; }) == false);
+    EXPECT("walk_segments.broken.count", count == 3);
+}
+
+TEST(TestDump, TestDumpAndRead)
+{
+    // [4 + 12] (4 + 44)
+    char memory[64];
+    auto manager = compact_segment_manager_t(memory, sizeof(memory));
+    ASSERT("manager.add_segment", manager.add_segment(12) != nullptr);
+
+    ASSERT("dump_segments", dump_segments(manager, dump_path) == true);
+
+    segment_dump_reader_t reader;
+    ASSERT("reader.open", reader.open(dump_path) == true);
+
+    auto const& header = reader.header();
+    EXPECT("reader.header", header.version == segment_dump_header_t::current_version && header.segment_bytes == 4 && header.bytes == 64 && header.count == 2);
+
+    segment_info_t info;
+    EXPECT("reader.read.used", reader.read(info) && info.offset == 0 && info.size == 12 && info.is_used && info.tag == 0);
+    EXPECT("reader.read.free", reader.read(info) && info.offset == 16 && info.size == 44 && !info.is_used);
+    EXPECT("reader.read.end", reader.read(info) == false);
+
+    reader.close();
+    std::remove(dump_path);
+    EXPECT("reader.open.missing", reader.open(dump_path) == false);
+}
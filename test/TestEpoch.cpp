@@ -0,0 +1,168 @@
+#include <EightmoryTestingBase.hpp>
+
+#include <Eightmory/Epoch.hpp>
+
+#include <atomic> // atomic
+#include <thread> // thread
+#include <vector> // vector
+
+using eightmory::segment_manager_t;
+
+using eightmory::epoch_domain_t;
+using eightmory::epoch_participant_t;
+using eightmory::epoch_guard_t;
+using eightmory::epoch_segment_manager_t;
+
+TEST_SPACE()
+{
+
+struct reclaimed_t
+{
+    std::vector<void*> memory;
+};
+
+void reclaim(void* context, void* const* memory, std::size_t count) noexcept
+{
+    auto reclaimed = static_cast<reclaimed_t*>(context);
+    reclaimed->memory.insert(reclaimed->memory.end(), memory, memory + count);
+}
+
+struct node_t
+{
+    std::atomic<node_t*> next;
+    std::size_t value;
+};
+
+static constexpr auto node_value = std::size_t(0x8E16);
+
+} // TEST_SPACE
+
+TEST(TestEpoch, TestRetire)
+{
+    auto reclaimed = reclaimed_t{};
+    auto domain = epoch_domain_t(&reclaim, &reclaimed);
+
+    int objects[2] = {};
+    {
+        auto writer = epoch_participant_t(domain);
+        auto reader = epoch_participant_t(domain);
+        ASSERT("participant.is_registered", writer.is_registered() && reader.is_registered());
+
+        EXPECT("writer.retire", writer.retire(&objects[0]) && writer.retired_count() == 1);
+
+        domain.try_advance();
+        EXPECT("writer.reclaim.early", writer.reclaim() == 0);
+
+        // reader in epoch 1 allows single advance only
+        reader.enter();
+        EXPECT("domain.try_advance", domain.try_advance() && domain.epoch() == 2);
+        EXPECT("domain.try_advance.blocked", !domain.try_advance() && domain.epoch() == 2);
+
+        EXPECT("writer.reclaim", writer.reclaim() == 1 && reclaimed.memory.size() == 1 && reclaimed.memory[0] == &objects[0]);
+
+        writer.retire(&objects[1]);
+        domain.try_advance();
+        EXPECT("writer.reclaim.reader", writer.reclaim() == 0);
+
+        // nested sections keep epoch until last leave
+        reader.enter();
+        reader.leave();
+        EXPECT("reader.is_active", reader.is_active());
+        reader.leave();
+
+        writer.synchronize();
+        EXPECT("writer.synchronize", writer.retired_count() == 0 && reclaimed.memory.size() == 2);
+    }
+
+    // released slots are reused
+    auto participant = epoch_participant_t(domain);
+    EXPECT("participant.reuse", participant.is_registered());
+}
+
+TEST(TestEpoch, TestManager)
+{
+    char memory[8192];
+    auto manager = segment_manager_t(memory, sizeof(memory));
+    auto epoch_manager = epoch_segment_manager_t(manager);
+
+    {
+        auto participant = epoch_participant_t(epoch_manager.domain());
+        for (std::size_t index = 0; index < 200; ++index)
+        {
+            auto node = epoch_manager.add_segment(16);
+            ASSERT("epoch_manager.add_segment", node != nullptr);
+            epoch_manager.retire_segment(participant, node);
+        }
+
+        // reclaimed by batches during retire
+        EXPECT("epoch_manager.reclaimed_count.batch", epoch_manager.reclaimed_count() > 0);
+    }
+    EXPECT("epoch_manager.reclaimed_count", epoch_manager.reclaimed_count() == 200);
+
+    auto whole = manager.add_segment(sizeof(memory) - 2 * sizeof(eightmory::segment_t));
+    EXPECT("manager.add_segment.whole", whole != nullptr);
+}
+
+TEST(TestEpoch, TestConcurrentStack)
+{
+    auto const thread_count = std::size_t(4);
+    auto const round_count = std::size_t(2000);
+
+    std::vector<char> memory(64 * 1024);
+    auto manager = segment_manager_t(memory.data(), memory.size());
+    auto epoch_manager = epoch_segment_manager_t(manager);
+
+    std::atomic<node_t*> head{nullptr};
+    std::atomic<bool> is_valid{true};
+    std::atomic<std::size_t> pop_count{0};
+
+    std::vector<std::thread> threads;
+    for (std::size_t thread = 0; thread < thread_count; ++thread)
+    {
+        threads.emplace_back([&]
+        {
+            auto participant = epoch_participant_t(epoch_manager.domain());
+            for (std::size_t round = 0; round < round_count; ++round)
+            {
+                if (auto node = static_cast<node_t*>(epoch_manager.add_segment(sizeof(node_t))))
+                {
+                    node->value = node_value;
+                    auto next = head.load();
+                    do node->next.store(next); while (!head.compare_exchange_weak(next, node));
+                }
+
+                node_t* popped = nullptr;
+                {
+                    auto guard = epoch_guard_t(participant);
+
+                    // node read in critical section cannot be reclaimed and reused
+                    popped = head.load();
+                    while (popped != nullptr && !head.compare_exchange_weak(popped, popped->next.load()))
+                        ;
+
+                    if (popped != nullptr && popped->value != node_value) is_valid = false;
+                }
+
+                if (popped != nullptr)
+                {
+                    ++pop_count;
+                    epoch_manager.retire_segment(participant, popped);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    auto stack_count = std::size_t(0);
+    for (auto node = head.load(); node != nullptr; node = node->next.load())
+    {
+        ++stack_count;
+    }
+
+    EXPECT("epoch.concurrent.is_valid", is_valid == true);
+    EXPECT("epoch.concurrent.reclaimed_count", epoch_manager.reclaimed_count() == pop_count);
+    EXPECT("epoch.concurrent.count", pop_count + stack_count == thread_count * round_count);
+}
@@ -0,0 +1,241 @@
+#include <EightmoryTestingBase.hpp>
+
+#include <Eightmory/Guarded.hpp>
+
+#include <cstdint> // uintptr_t
+#include <cstring> // strstr
+
+#ifndef _WIN32
+#include <sys/wait.h> // waitpid
+#include <unistd.h> // fork, pipe, dup2
+#include <csignal> // SIGSEGV, SIGBUS
+#include <setjmp.h> // sigsetjmp, siglongjmp
+#include <sys/mman.h> // mmap
+#endif // _WIN32
+
+using eightmory::segment_manager_t;
+
+using eightmory::guarded_fault_t;
+using eightmory::guarded_pool_t;
+using eightmory::guarded_segment_manager_t;
+
+#ifndef _WIN32
+TEST_SPACE()
+{
+
+sigjmp_buf recover_point;
+int volatile recover_count = 0;
+
+// previous handler of application, which recovers from faults
+void recover_handler(int, siginfo_t*, void*)
+{
+    recover_count = recover_count + 1;
+    siglongjmp(recover_point, 1);
+}
+
+// run function in child process, report is filled with its stderr
+// return 'count of report bytes'
+template <typename FunctionType>
+std::size_t read_child_report(FunctionType function, char (&report)[256], int& status)
+{
+    int pipe_files[2];
+    if (pipe(pipe_files) != 0)
+    {
+        return 0;
+    }
+
+    auto const child = fork();
+    if (child == 0)
+    {
+        dup2(pipe_files[1], 2);
+        function();
+        _exit(0);
+    }
+    close(pipe_files[1]);
+
+    auto count = std::size_t(0);
+    for (ssize_t read_count; count + 1 < sizeof(report) && (read_count = read(pipe_files[0], report + count, sizeof(report) - 1 - count)) > 0;)
+    {
+        count += static_cast<std::size_t>(read_count);
+    }
+    close(pipe_files[0]);
+
+    waitpid(child, &status, 0);
+    return count;
+}
+
+} // TEST_SPACE
+#endif // _WIN32
+
+TEST(TestGuarded, TestPool)
+{
+    guarded_pool_t pool;
+    ASSERT("pool.create", pool.create(2) == true);
+
+    auto const page_size = pool.page_size();
+    EXPECT("pool.allocate.too_big", pool.allocate(page_size + 1) == nullptr);
+
+    auto some_memory = static_cast<char*>(pool.allocate(24));
+    ASSERT("pool.allocate", some_memory != nullptr);
+    EXPECT("pool.allocate.right_aligned", (reinterpret_cast<std::uintptr_t>(some_memory) + 24) % page_size == 0);
+    EXPECT("pool.contains", pool.contains(some_memory) && !pool.contains(&pool));
+
+    // memory is accessible
+    for (std::size_t index = 0; index < 24; ++index) some_memory[index] = char(index);
+
+    EXPECT("pool.describe.overflow", pool.describe(some_memory + 24).fault == guarded_fault_t::overflow);
+    EXPECT("pool.describe.underflow", pool.describe(some_memory - 1).fault == guarded_fault_t::underflow);
+    EXPECT("pool.describe.report", pool.describe(some_memory + 24).memory == some_memory && pool.describe(some_memory + 24).size == 24);
+    EXPECT("pool.describe.valid", pool.describe(some_memory + 4).fault == guarded_fault_t::none);
+
+    // not power of two size is aligned to 8
+    auto other_memory = static_cast<char*>(pool.allocate(13));
+    ASSERT("pool.allocate.other", other_memory != nullptr);
+    EXPECT("pool.allocate.align", reinterpret_cast<std::uintptr_t>(other_memory) % 8 == 0);
+    EXPECT("pool.allocate.exhausted", pool.allocate(8) == nullptr);
+    EXPECT("pool.live_count", pool.live_count() == 2);
+
+    EXPECT("pool.deallocate", pool.deallocate(some_memory) == true);
+    EXPECT("pool.deallocate.double_free", pool.deallocate(some_memory) == false);
+    EXPECT("pool.deallocate.interior", pool.deallocate(other_memory + 1) == false);
+    EXPECT("pool.describe.use_after_free", pool.describe(some_memory).fault == guarded_fault_t::use_after_free);
+
+    // freed slot is reused last
+    EXPECT("pool.deallocate.other", pool.deallocate(other_memory) == true);
+    auto reused_memory = static_cast<char*>(pool.allocate(24));
+    EXPECT("pool.allocate.reuse", reused_memory == some_memory);
+}
+
+TEST(TestGuarded, TestAlignmentSlack)
+{
+    guarded_pool_t pool;
+    ASSERT("pool.create", pool.create(2) == true);
+
+    auto const page_size = pool.page_size();
+
+    // aligned memory ends up to 7 bytes before guard page, overflow into them is not trapped
+    auto aligned_memory = static_cast<char*>(pool.allocate(13));
+    ASSERT("pool.allocate", aligned_memory != nullptr);
+    auto const slack = page_size - (reinterpret_cast<std::uintptr_t>(aligned_memory) + 13) % page_size;
+    EXPECT("pool.allocate.slack", slack == 3);
+    aligned_memory[13 + slack - 1] = 1;
+
+    // align 1 is byte exact
+    auto exact_memory = static_cast<char*>(pool.allocate(13, 1));
+    ASSERT("pool.allocate.exact", exact_memory != nullptr);
+    EXPECT("pool.allocate.exact.slack", (reinterpret_cast<std::uintptr_t>(exact_memory) + 13) % page_size == 0);
+    EXPECT("pool.describe.exact", pool.describe(exact_memory + 13).fault == guarded_fault_t::overflow);
+}
+
+TEST(TestGuarded, TestSampling)
+{
+    char memory[256];
+    auto manager = segment_manager_t(memory, sizeof(memory));
+
+    guarded_pool_t pool;
+    ASSERT("pool.create", pool.create(4) == true);
+
+    // every allocation is sampled while pool has free slots
+    auto guarded = guarded_segment_manager_t<segment_manager_t>(manager, pool, 1);
+
+    auto guarded_count = std::size_t(0);
+    void* memories[8] = {};
+    for (auto& some_memory : memories)
+    {
+        some_memory = guarded.add_segment(8);
+        guarded_count += pool.contains(some_memory);
+    }
+    EXPECT("guarded.add_segment.sampled", guarded_count > 0 && guarded_count <= 4);
+
+    auto is_routed = true;
+    for (auto some_memory : memories)
+    {
+        is_routed &= some_memory != nullptr;
+        is_routed &= !pool.contains(some_memory) || guarded.extend_segment(some_memory, 4) == false;
+        is_routed &= guarded.remove_segment(some_memory);
+    }
+    EXPECT("guarded.remove_segment", is_routed);
+    EXPECT("pool.live_count", pool.live_count() == 0);
+
+    // empty allocation is placed inside of slot, so it's routed back to pool
+    void* empty_memory = nullptr;
+    while (!pool.contains(empty_memory))
+    {
+        if (empty_memory != nullptr) guarded.remove_segment(empty_memory);
+        empty_memory = guarded.add_segment(0);
+        ASSERT("guarded.add_segment.empty", empty_memory != nullptr);
+    }
+    EXPECT("guarded.remove_segment.empty", guarded.remove_segment(empty_memory) && pool.live_count() == 0);
+
+    auto unsampled = guarded_segment_manager_t<segment_manager_t>(manager, pool, 0);
+    auto some_memory = unsampled.add_segment(8);
+    EXPECT("unsampled.add_segment", some_memory != nullptr && !pool.contains(some_memory));
+}
+
+#ifndef _WIN32
+TEST(TestGuarded, TestTrap)
+{
+    int pipe_files[2];
+    ASSERT("pipe", pipe(pipe_files) == 0);
+
+    auto const child = fork();
+    ASSERT("fork", child != -1);
+    if (child == 0)
+    {
+        dup2(pipe_files[1], 2);
+
+        guarded_pool_t pool;
+        pool.create(1);
+        pool.install_fault_handler();
+
+        auto some_memory = static_cast<char volatile*>(pool.allocate(16));
+        some_memory[16] = 1; // overflow by one byte
+        _exit(0);
+    }
+    close(pipe_files[1]);
+
+    char report[256] = {};
+    auto count = std::size_t(0);
+    for (ssize_t read_count; count + 1 < sizeof(report) && (read_count = read(pipe_files[0], report + count, sizeof(report) - 1 - count)) > 0;)
+    {
+        count += static_cast<std::size_t>(read_count);
+    }
+    close(pipe_files[0]);
+
+    int status = 0;
+    waitpid(child, &status, 0);
+
+    EXPECT("trap.signal", WIFSIGNALED(status) && (WTERMSIG(status) == SIGSEGV || WTERMSIG(status) == SIGBUS));
+    EXPECT("trap.report", std::strstr(report, "heap-buffer-overflow") != nullptr && std::strstr(report, "16 bytes") != nullptr);
+}
+
+TEST(TestGuarded, TestChain)
+{
+    char report[256] = {};
+    int status = 0;
+    read_child_report([]
+    {
+        struct sigaction action = {};
+        action.sa_sigaction = recover_handler;
+        action.sa_flags = SA_SIGINFO | SA_NODEFER;
+        sigemptyset(&action.sa_mask);
+        sigaction(SIGSEGV, &action, nullptr);
+        sigaction(SIGBUS, &action, nullptr);
+
+        guarded_pool_t pool;
+        pool.create(1);
+        pool.install_fault_handler();
+
+        auto other_memory = static_cast<char volatile*>(mmap(nullptr, pool.page_size(), PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+        auto some_memory = static_cast<char volatile*>(pool.allocate(16));
+
+        // fault outside of pool goes to previous handler, pool handler stays installed
+        if (sigsetjmp(recover_point, 1) == 0) other_memory[0] = 1;
+        if (sigsetjmp(recover_point, 1) == 0) some_memory[16] = 1;
+        _exit(recover_count);
+    }, report, status);
+
+    EXPECT("chain.recovered", WIFEXITED(status) && WEXITSTATUS(status) == 2);
+    EXPECT("chain.report", std::strstr(report, "heap-buffer-overflow") != nullptr && std::strstr(report, "wild") == nullptr);
+}
+#endif // _WIN32
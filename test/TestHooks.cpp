@@ -0,0 +1,112 @@
+#include <EightmoryTestingBase.hpp>
+
+#include <Eightmory/Hooks.hpp>
+
+#include <vector> // vector
+
+using eightmory::segment_t;
+using eightmory::first_fit_t;
+using eightmory::eager_coalesce_t;
+using eightmory::no_stats_t;
+using eightmory::basic_segment_manager_t;
+
+using eightmory::callback_hooks_t;
+using eightmory::hooked_segment_manager_t;
+
+static_assert(sizeof(eightmory::segment_manager_t) == 2 * sizeof(segment_t*) + debug_manager_bytes, "Disabled hooks must not take memory.");
+
+TEST_SPACE()
+{
+
+enum class event_kind_t { allocate, free, extend, coalesce };
+
+struct event_t
+{
+    event_kind_t kind;
+    void* memory;
+    std::size_t size;
+
+    bool operator==(event_t const& other) const noexcept
+    {
+        return kind == other.kind && memory == other.memory && size == other.size;
+    }
+};
+
+struct recording_hooks_t
+{
+    std::vector<event_t> events;
+
+    void allocate(void* memory, std::size_t size, std::uint32_t) { events.push_back({event_kind_t::allocate, memory, size}); }
+    void free(void* memory, std::size_t size, std::uint32_t) { events.push_back({event_kind_t::free, memory, size}); }
+    void extend(void* memory, std::size_t size, std::uint32_t) { events.push_back({event_kind_t::extend, memory, size}); }
+    void coalesce(void* memory, std::size_t size) { events.push_back({event_kind_t::coalesce, memory, size}); }
+};
+
+} // TEST_SPACE
+
+TEST(TestHooks, TestPolicyHooks)
+{
+    // [8 + 8] [8 + 8] (8 + 24)
+    char memory[64];
+    auto manager = basic_segment_manager_t<first_fit_t, eager_coalesce_t, segment_t, no_stats_t, recording_hooks_t>(memory, sizeof(memory));
+
+    auto lhs_memory = manager.add_segment(8);
+    auto rhs_memory = manager.add_segment(8);
+    ASSERT("manager.add_segment", lhs_memory != nullptr && rhs_memory != nullptr);
+
+    // [8 + 8] (8 + 8 + 8 + 24)
+    manager.remove_segment(rhs_memory);
+
+    // [8 + 12] (8 + 36)
+    manager.extend_segment(lhs_memory, 4);
+
+    // [8 + 56]
+    manager.extend_segment(lhs_memory);
+
+    auto const& events = manager.hooks().events;
+    auto const expected = std::vector<event_t>
+    {
+        {event_kind_t::allocate, lhs_memory, 8},
+        {event_kind_t::allocate, rhs_memory, 8},
+        {event_kind_t::free, rhs_memory, 8},
+        {event_kind_t::coalesce, rhs_memory, 40},
+        {event_kind_t::extend, lhs_memory, 12},
+        {event_kind_t::coalesce, lhs_memory, 56},
+        {event_kind_t::extend, lhs_memory, 56},
+    };
+    EXPECT("manager.hooks", events == expected);
+}
+
+TEST(TestHooks, TestCallbackHooks)
+{
+    char memory[64];
+    auto manager = hooked_segment_manager_t(memory, sizeof(memory));
+
+    // unset callbacks are skipped
+    auto other_memory = manager.add_segment(8);
+    ASSERT("manager.add_segment", other_memory != nullptr);
+
+    struct counter_t
+    {
+        std::size_t allocated = 0;
+        std::size_t freed = 0;
+    } counter;
+
+    manager.hooks().context = &counter;
+    manager.hooks().on_allocate = [](void* context, void*, std::size_t size, std::uint32_t)
+    {
+        static_cast<counter_t*>(context)->allocated += size;
+    };
+    manager.hooks().on_free = [](void* context, void*, std::size_t size, std::uint32_t)
+    {
+        static_cast<counter_t*>(context)->freed += size;
+    };
+
+    auto some_memory = manager.add_segment(16);
+    ASSERT("manager.add_segment", some_memory != nullptr);
+    manager.remove_segment(some_memory);
+    manager.remove_segment(other_memory);
+
+    EXPECT("callback_hooks.on_allocate", counter.allocated == 16);
+    EXPECT("callback_hooks.on_free", counter.freed == 24);
+}
@@ -6,17 +6,28 @@
 using eightmory::segment_t;
 using eightmory::segment_manager_t;
 
+using eightmory::compact_segment_t;
+using eightmory::compact_segment_manager_t;
+
+using eightmory::basic_segment_manager_t;
+using eightmory::first_fit_t;
+using eightmory::best_fit_t;
+using eightmory::lazy_coalesce_t;
+using eightmory::eager_coalesce_t;
+
 using eightmory::align_up;
 using eightmory::is_aligned;
 
 using segment_trace_t = std::vector<std::pair<std::size_t, bool>>;
 
 static_assert(sizeof(segment_t) == 8, "Exactly 8 bytes per 'segment_t' are required for tests.");
+static_assert(sizeof(compact_segment_t) == 4, "Exactly 4 bytes per 'compact_segment_t' are required for tests.");
 
 TEST_SPACE()
 {
 
-std::size_t segment_count(segment_manager_t const& manager) noexcept
+template <typename ManagerType>
+std::size_t segment_count(ManagerType const& manager) noexcept
 {
     auto counter = std::size_t(0);
     for (auto segment = manager.begin(); segment != manager.end(); segment = segment->next())
@@ -54,7 +65,8 @@ void segment_defragmentation(segment_manager_t& manager) noexcept
     return nullptr;
 }
 
-segment_trace_t segment_trace(segment_manager_t& manager)
+template <typename ManagerType>
+segment_trace_t segment_trace(ManagerType& manager)
 {
     segment_trace_t trace;
     for (auto segment = manager.begin(); segment != manager.end(); segment = segment->next())
@@ -1424,6 +1436,203 @@ TEST(TestLibrary, TestComplexWithoutDefragmentation)
     EXPECT("manager.trace.four_size_segment", segment_trace(manager) == segment_trace_t{{1, false}, {2, false}, {4, false}, {1, false}});
 }
 
+TEST(TestLibrary, TestCompactManager)
+{
+    // (4 + 28)
+    char memory[32];
+    auto manager = compact_segment_manager_t(memory, sizeof(memory));
+
+    static const auto eight_size = 8;
+    static const auto twelve_size = 12;
+
+
+    EXPECT("manager.trace", segment_trace(manager) == segment_trace_t{{28, false}});
+    EXPECT("manager.max_size", compact_segment_t::max_size == 0x7FFFFFFF);
+
+    // [4 + 8] (4 + 16)
+    auto eight_size_memory = manager.add_segment(eight_size);
+    ASSERT("manager.add_segment.eight_size_segment", eight_size_memory != nullptr);
+    EXPECT("manager.add_segment.eight_size_segment.memory", eight_size_memory == memory + sizeof(compact_segment_t));
+
+    auto eight_size_segment = compact_segment_t::segment(eight_size_memory);
+    EXPECT("manager.add_segment.eight_size_segment.size", eight_size_segment->size == eight_size);
+    EXPECT("manager.add_segment.eight_size_segment.is_used", eight_size_segment->is_used == true);
+
+    EXPECT("manager.trace.eight_size_segment", segment_trace(manager) == segment_trace_t{{8, true}, {16, false}});
+
+    // [4 + 8] [4 + 12] (4 + 0)
+    auto twelve_size_memory = manager.add_segment(twelve_size);
+    ASSERT("manager.add_segment.twelve_size_segment", twelve_size_memory != nullptr);
+
+    EXPECT("manager.trace.twelve_size_segment", segment_trace(manager) == segment_trace_t{{8, true}, {12, true}, {0, false}});
+
+    // [4 + 28]
+    EXPECT("manager.extend_segment.eight_size_segment", manager.extend_segment(eight_size_memory, 2) == false);
+    manager.remove_segment(twelve_size_memory);
+    EXPECT("manager.extend_segment.eight_size_segment", manager.extend_segment(eight_size_memory) == true);
+
+    EXPECT("manager.trace.extend_segment", segment_trace(manager) == segment_trace_t{{28, true}});
+
+
+    // (4 + 28)
+    manager.remove_segment(eight_size_memory);
+    EXPECT("manager.trace.remove_segment", segment_trace(manager) == segment_trace_t{{28, false}});
+}
+
+TEST(TestLibrary, TestCompactInvalidManager)
+{
+    char memory[3];
+    auto invalid_size_manager = compact_segment_manager_t(memory, sizeof(memory));
+
+    ASSERT("invalid_size_manager.begin", invalid_size_manager.begin() == nullptr);
+    ASSERT("invalid_size_manager.bytes", invalid_size_manager.bytes() == 0);
+
+    // buffer is not touched, since size is checked first
+    auto over_size_manager = compact_segment_manager_t(memory, compact_segment_t::max_size + 1);
+
+    ASSERT("over_size_manager.begin", over_size_manager.begin() == nullptr);
+    ASSERT("over_size_manager.bytes", over_size_manager.bytes() == 0);
+}
+
+TEST(TestLibrary, TestBestFitManager)
+{
+    // (8 + 72)
+    char memory[80];
+    auto manager = basic_segment_manager_t<best_fit_t, lazy_coalesce_t, segment_t>(memory, sizeof(memory));
+
+    // [8 + 8] [8 + 4] [8 + 2] (8 + 34)
+    auto eight_size_memory = manager.add_segment(8);
+    auto four_size_memory = manager.add_segment(4);
+    auto two_size_memory = manager.add_segment(2);
+    ASSERT("manager.add_segment", eight_size_memory != nullptr && four_size_memory != nullptr && two_size_memory != nullptr);
+
+    EXPECT("manager.trace", segment_trace(manager) == segment_trace_t{{8, true}, {4, true}, {2, true}, {34, false}});
+
+    // (8 + 8) [8 + 4] (8 + 2) (8 + 34)
+    manager.remove_segment(eight_size_memory);
+    manager.remove_segment(two_size_memory);
+
+    EXPECT("manager.trace.remove_segment", segment_trace(manager) == segment_trace_t{{8, false}, {4, true}, {2, false}, {34, false}});
+
+    // (8 + 8) [8 + 4] [8 + 2] (8 + 34)
+    auto best_memory = manager.add_segment(2);
+    EXPECT("manager.add_segment.best_segment", best_memory == two_size_memory);
+
+    EXPECT("manager.trace.best_segment", segment_trace(manager) == segment_trace_t{{8, false}, {4, true}, {2, true}, {34, false}});
+}
+
+TEST(TestLibrary, TestEagerCoalesceManager)
+{
+    // (8 + 40)
+    char memory[48];
+    auto manager = basic_segment_manager_t<first_fit_t, eager_coalesce_t, segment_t>(memory, sizeof(memory));
+
+    // [8 + 8] [8 + 4] (8 + 12)
+    auto eight_size_memory = manager.add_segment(8);
+    auto four_size_memory = manager.add_segment(4);
+    ASSERT("manager.add_segment", eight_size_memory != nullptr && four_size_memory != nullptr);
+
+    EXPECT("manager.trace", segment_trace(manager) == segment_trace_t{{8, true}, {4, true}, {12, false}});
+
+    // [8 + 8] (8 + 24)
+    manager.remove_segment(four_size_memory);
+    EXPECT("manager.trace.four_size_segment", segment_trace(manager) == segment_trace_t{{8, true}, {24, false}});
+
+    // (8 + 40)
+    manager.remove_segment(eight_size_memory);
+    EXPECT("manager.trace.eight_size_segment", segment_trace(manager) == segment_trace_t{{40, false}});
+}
+
+#ifdef EIGHTMORY_DEBUG
+TEST(TestLibrary, TestDebugValidation)
+{
+    // [8 + 8] [8 + 32] (8 + 16)
+    char memory[80];
+    auto manager = segment_manager_t(memory, sizeof(memory));
+
+    auto eight_size_memory = manager.add_segment(8);
+    auto data_memory = manager.add_segment(32);
+    ASSERT("manager.add_segment", eight_size_memory != nullptr && data_memory != nullptr);
+
+    char outside[16];
+    EXPECT("manager.remove_segment.outside", manager.remove_segment(outside + 8) == false);
+    EXPECT("manager.remove_segment.before_begin", manager.remove_segment(memory) == false);
+    EXPECT("manager.extend_segment.after_end", manager.extend_segment(memory + sizeof(memory) + 8) == false);
+
+    // payload read as header
+    for (std::size_t index = 0; index < 32; ++index)
+    {
+        reinterpret_cast<unsigned char*>(data_memory)[index] = 0xFF;
+    }
+    EXPECT("manager.remove_segment.interior", manager.remove_segment(reinterpret_cast<char*>(data_memory) + 16) == false);
+    EXPECT("manager.extend_segment.interior", manager.extend_segment(reinterpret_cast<char*>(data_memory) + 16, 4) == false);
+
+    EXPECT("manager.remove_segment", manager.remove_segment(eight_size_memory) == true);
+    EXPECT("manager.remove_segment.double_free", manager.remove_segment(eight_size_memory) == false);
+
+    EXPECT("manager.trace", segment_trace(manager) == segment_trace_t{{8, false}, {32, true}, {16, false}});
+}
+
+TEST(TestLibrary, TestDebugValidationZeroed)
+{
+    // [8 + 32] (8 + 32)
+    char memory[80];
+    auto manager = segment_manager_t(memory, sizeof(memory));
+
+    auto data_memory = static_cast<char*>(manager.add_segment(32));
+    ASSERT("manager.add_segment", data_memory != nullptr);
+
+    // zeros look like consistent free headers of zero size
+    for (std::size_t index = 0; index < 32; ++index)
+    {
+        data_memory[index] = 0;
+    }
+    EXPECT("manager.extend_segment.interior", manager.extend_segment(data_memory + 16) == false);
+    EXPECT("manager.extend_segment.interior.size", manager.extend_segment(data_memory + 8, 4) == false);
+    EXPECT("manager.remove_segment.interior", manager.remove_segment(data_memory + 16) == false);
+
+    auto is_zeroed = true;
+    for (std::size_t index = 0; index < 32; ++index)
+    {
+        is_zeroed = is_zeroed && data_memory[index] == 0;
+    }
+    EXPECT("manager.payload", is_zeroed);
+    EXPECT("manager.trace", segment_trace(manager) == segment_trace_t{{32, true}, {32, false}});
+
+    // free segment is extended in both build modes, defragmentation relies on it
+    EXPECT("manager.remove_segment", manager.remove_segment(data_memory) == true);
+    EXPECT("manager.extend_segment.free", manager.extend_segment(data_memory) == true);
+}
+
+TEST(TestLibrary, TestDebugValidationAttached)
+{
+    char memory[128];
+    auto manager = segment_manager_t(memory, sizeof(memory));
+    auto data_memory = static_cast<char*>(manager.add_segment(32));
+    ASSERT("manager.add_segment", data_memory != nullptr);
+
+    // headers of attached heap are tracked by single walk
+    auto attached_manager = segment_manager_t::attach(memory, sizeof(memory));
+    for (std::size_t index = 0; index < 32; ++index)
+    {
+        data_memory[index] = 0;
+    }
+    EXPECT("attached_manager.remove_segment.interior", attached_manager.remove_segment(data_memory + 16) == false);
+    EXPECT("attached_manager.remove_segment", attached_manager.remove_segment(data_memory) == true);
+
+    // segment created by other manager over same heap is unknown, unless tracking is disabled
+    auto reused_memory = manager.add_segment(16);
+    auto other_memory = manager.add_segment(8);
+    ASSERT("manager.add_segment.other", reused_memory == data_memory && other_memory != nullptr);
+    EXPECT("attached_manager.remove_segment.unknown", attached_manager.remove_segment(other_memory) == false);
+
+    EXPECT("attached_manager.is_segment_tracking", attached_manager.is_segment_tracking());
+    attached_manager.disable_segment_tracking();
+    EXPECT("attached_manager.disable_segment_tracking", !attached_manager.is_segment_tracking());
+    EXPECT("attached_manager.remove_segment.untracked", attached_manager.remove_segment(other_memory) == true);
+}
+#endif // EIGHTMORY_DEBUG
+
 TEST(TestLibrary, TestAlign)
 {
     EXPECT("align_up.common0", align_up(0, 1) == 0 && align_up(0, 8) == 0 && align_up(1, 1) == 1 && align_up(1, 8) == 8 && align_up(8, 8) == 8 && align_up(9, 8) == 16);
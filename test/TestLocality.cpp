@@ -0,0 +1,106 @@
+#include <EightmoryTestingBase.hpp>
+
+#include <Eightmory/Locality.hpp>
+
+using eightmory::segment_t;
+using eightmory::tagged_segment_t;
+using eightmory::first_fit_t;
+using eightmory::lazy_coalesce_t;
+using eightmory::basic_segment_manager_t;
+using eightmory::basic_locality_segment_manager_t;
+using eightmory::locality_segment_manager_t;
+
+TEST_SPACE()
+{
+
+using tagged_locality_segment_manager_t = basic_locality_segment_manager_t
+<
+    basic_segment_manager_t<first_fit_t, lazy_coalesce_t, tagged_segment_t>
+>;
+
+char* as_bytes(void* memory) noexcept
+{
+    return static_cast<char*>(memory);
+}
+
+} // TEST_SPACE
+
+TEST(TestLocality, TestNear)
+{
+    char memory[1024];
+    auto manager = locality_segment_manager_t(memory, sizeof(memory));
+
+    // heap with holes before object
+    void* blocks[6] = {};
+    for (auto& block : blocks)
+    {
+        block = manager.add_segment(32);
+    }
+    manager.remove_segment(blocks[1]);
+    manager.remove_segment(blocks[3]);
+
+    // plain allocation fills first hole, near allocation follows object
+    auto near = manager.add_segment_near(32, blocks[4]);
+    EXPECT("manager.add_segment_near", as_bytes(near) == as_bytes(blocks[5]) + 32 + sizeof(segment_t));
+
+    auto plain = manager.add_segment(32);
+    EXPECT("manager.add_segment", plain == blocks[1]);
+
+    // near allocations fill heap tail, then search starts from begin
+    auto last = near;
+    auto next = manager.add_segment_near(32, last);
+    while (next != nullptr && as_bytes(next) > as_bytes(last))
+    {
+        last = next;
+        next = manager.add_segment_near(32, last);
+    }
+    EXPECT("manager.add_segment_near.fallback", next == blocks[3]);
+}
+
+TEST(TestLocality, TestGroup)
+{
+    char memory[2048];
+    auto manager = locality_segment_manager_t(memory, sizeof(memory));
+
+    // components of entity are allocated between unrelated allocations
+    void* members[4] = {};
+    for (auto& member : members)
+    {
+        auto unrelated = manager.add_segment(16);
+        member = manager.add_segment_to_group(24, 3);
+        ASSERT("manager.add_segment_to_group", member != nullptr && unrelated != nullptr);
+
+        manager.remove_segment(unrelated);
+    }
+
+    // members follow each other and holes of unrelated segments are left behind
+    for (std::size_t index = 1; index < 4; ++index)
+    {
+        EXPECT("manager.group.contiguous", as_bytes(members[index]) == as_bytes(members[index - 1]) + 24 + sizeof(segment_t));
+    }
+    EXPECT("manager.cursor", manager.cursor(3) == segment_t::segment(members[3]));
+    EXPECT("manager.add_segment_to_group.invalid", manager.add_segment_to_group(8, locality_segment_manager_t::group_count) == nullptr);
+
+    // removed cursor is reset, so it is never used as hint after merge
+    manager.remove_segment(members[3]);
+    EXPECT("manager.cursor.reset", manager.cursor(3) == nullptr);
+
+    auto next = manager.add_segment_to_group(24, 3);
+    EXPECT("manager.add_segment_to_group.reset", next != nullptr && manager.cursor(3) == segment_t::segment(next));
+}
+
+TEST(TestLocality, TestTaggedGroup)
+{
+    char memory[1024];
+    auto manager = tagged_locality_segment_manager_t(memory, sizeof(memory));
+
+    auto lhs = manager.add_segment_to_group(16, 5);
+    auto rhs = manager.add_segment_to_group(16, 5);
+    ASSERT("manager.add_segment_to_group", lhs != nullptr && rhs != nullptr);
+
+    // group is stored as tag
+    EXPECT("manager.group.tag", tagged_segment_t::segment(rhs)->tag == 5);
+
+    manager.remove_segment(rhs);
+    EXPECT("manager.cursor.reset", manager.cursor(5) == nullptr);
+}
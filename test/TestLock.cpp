@@ -0,0 +1,56 @@
+#include <EightmoryTestingBase.hpp>
+
+#include <Eightmory/Lock.hpp>
+
+#include <thread> // thread
+#include <vector> // vector
+
+using eightmory::spin_lock_t;
+
+TEST(TestLock, TestOwner)
+{
+    spin_lock_t lock;
+    EXPECT("lock.owner.unlocked", lock.owner() == 0 && lock.wait(0));
+
+    ASSERT("lock.try_lock", lock.try_lock(7));
+    EXPECT("lock.owner", lock.owner() == 7);
+    EXPECT("lock.try_lock.locked", !lock.try_lock(8));
+    EXPECT("lock.wait.locked", !lock.wait(16));
+
+    // only current owner may be replaced
+    EXPECT("lock.take_over.other", !lock.take_over(8, 9) && lock.owner() == 7);
+    EXPECT("lock.take_over", lock.take_over(7, 9) && lock.owner() == 9);
+
+    lock.unlock();
+    EXPECT("lock.unlock", lock.owner() == 0 && lock.try_lock());
+    lock.unlock();
+}
+
+TEST(TestLock, TestConcurrentAccess)
+{
+    static const auto thread_count = 4;
+    static const auto iteration_count = 10000;
+
+    spin_lock_t lock;
+    auto counter = 0;
+
+    std::vector<std::thread> threads;
+    for (auto index = 0; index < thread_count; ++index)
+    {
+        threads.emplace_back([&lock, &counter]
+        {
+            for (auto iteration = 0; iteration < iteration_count; ++iteration)
+            {
+                lock.lock();
+                ++counter;
+                lock.unlock();
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    EXPECT("lock.counter", counter == thread_count * iteration_count);
+}
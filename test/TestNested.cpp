@@ -0,0 +1,157 @@
+#include <EightmoryTestingBase.hpp>
+
+#include <Eightmory/Nested.hpp>
+#include <Eightmory/Hooks.hpp>
+
+#include <cstdint> // uintptr_t
+
+using eightmory::segment_t;
+using eightmory::segment_manager_t;
+using eightmory::compact_segment_manager_t;
+using eightmory::nested_segment_manager_t;
+using eightmory::hooked_segment_manager_t;
+
+TEST(TestNested, TestRelease)
+{
+    char memory[4096];
+    auto parent = segment_manager_t(memory, sizeof(memory));
+
+    auto level = nested_segment_manager_t<segment_manager_t>(parent);
+    ASSERT("level.create", level.create(1024, false));
+    EXPECT("level.bytes", level.bytes() >= 1024 && level.is_open());
+
+    for (std::size_t index = 0; index < 16; ++index)
+    {
+        EXPECT("level.add_segment", level.add_segment(32) != nullptr);
+    }
+
+    // child is not growable, so it does not take more from parent
+    EXPECT("level.add_segment.full", level.add_segment(1024) == nullptr);
+
+    // all child segments are freed by single remove on parent
+    level.close();
+    EXPECT("level.close", !level.is_open() && level.add_segment(8) == nullptr);
+    EXPECT("parent.add_segment.whole", parent.add_segment(sizeof(memory) - sizeof(segment_t)) != nullptr);
+}
+
+TEST(TestNested, TestReset)
+{
+    char memory[2048];
+    auto parent = segment_manager_t(memory, sizeof(memory));
+
+    auto request = nested_segment_manager_t<segment_manager_t>(parent);
+    ASSERT("request.create", request.create(512, false));
+
+    auto first = request.add_segment(64);
+    while (request.add_segment(64) != nullptr);
+
+    // per-request scope is reused without returning segment to parent
+    request.reset();
+    EXPECT("request.reset", request.add_segment(64) == first);
+    EXPECT("request.reset.parent", parent.begin()->memory() == request.memory());
+}
+
+TEST(TestNested, TestGrow)
+{
+    char memory[4096];
+    auto parent = segment_manager_t(memory, sizeof(memory));
+
+    auto child = nested_segment_manager_t<segment_manager_t, compact_segment_manager_t>(parent);
+    ASSERT("child.create", child.create(256));
+
+    auto const bytes = child.bytes();
+    void* blocks[8] = {};
+    for (auto& block : blocks)
+    {
+        block = child.add_segment(100);
+        ASSERT("child.add_segment", block != nullptr);
+    }
+
+    // child grew in place by extending segment of parent
+    EXPECT("child.grow", child.bytes() > bytes && child.memory() == parent.begin()->memory());
+    EXPECT("child.grow.parent", segment_t::segment(child.memory())->size == child.bytes());
+
+    // growth is blocked by used rhs segment of parent
+    auto blocker = parent.add_segment(16);
+    ASSERT("parent.add_segment", blocker != nullptr);
+    EXPECT("child.grow.blocked", !child.grow(64));
+
+    for (auto block : blocks)
+    {
+        EXPECT("child.remove_segment", child.remove_segment(block));
+    }
+
+    // nested children of child
+    auto grandchild = nested_segment_manager_t<decltype(child), segment_manager_t>(child);
+    ASSERT("grandchild.create", grandchild.create(128));
+    EXPECT("grandchild.add_segment", grandchild.add_segment(64) != nullptr);
+    grandchild.close();
+
+    child.close();
+    parent.remove_segment(blocker);
+    EXPECT("parent.add_segment.whole", parent.add_segment(sizeof(memory) - sizeof(segment_t)) != nullptr);
+}
+
+TEST(TestNested, TestExtendHeap)
+{
+    char memory[1024];
+    auto manager = segment_manager_t(memory, 512);
+
+    auto block = manager.add_segment(512 - sizeof(segment_t));
+    EXPECT("manager.add_segment.full", block != nullptr && manager.add_segment(8) == nullptr);
+
+    EXPECT("manager.extend_heap.small", !manager.extend_heap(sizeof(segment_t) - 1));
+    EXPECT("manager.extend_heap", manager.extend_heap(512) && manager.bytes() == 1024);
+    EXPECT("manager.extend_segment", manager.extend_segment(block));
+    EXPECT("manager.extend_segment.size", segment_t::segment(block)->size == 1024 - sizeof(segment_t));
+}
+
+TEST(TestNested, TestHooks)
+{
+    char memory[2048];
+    auto parent = segment_manager_t(memory, sizeof(memory));
+
+    auto child = nested_segment_manager_t<segment_manager_t, hooked_segment_manager_t>(parent);
+
+    auto allocated = std::size_t(0);
+    child.manager().hooks().context = &allocated;
+    child.manager().hooks().on_allocate = [](void* context, void*, std::size_t size, std::uint32_t)
+    {
+        *static_cast<std::size_t*>(context) += size;
+    };
+
+    // hooks installed before create survive create, reset and close
+    ASSERT("child.create", child.create(512, false));
+    EXPECT("child.add_segment", child.add_segment(16) != nullptr && allocated == 16);
+
+    child.reset();
+    EXPECT("child.reset", child.add_segment(32) != nullptr && allocated == 48);
+
+    child.close();
+    ASSERT("child.create.again", child.create(512, false));
+    EXPECT("child.close", child.add_segment(64) != nullptr && allocated == 112);
+}
+
+TEST(TestNested, TestAlignment)
+{
+    // memory of compact parent segments is 4 bytes aligned
+    alignas(segment_t) char memory[1024];
+    auto parent = compact_segment_manager_t(memory, sizeof(memory));
+
+    auto child = nested_segment_manager_t<compact_segment_manager_t, segment_manager_t>(parent);
+    ASSERT("child.create", child.create(256));
+
+    // child heap is moved to alignment of its headers
+    auto const begin = reinterpret_cast<std::uintptr_t>(child.manager().begin());
+    EXPECT("child.alignment", begin % alignof(segment_t) == 0 && begin > reinterpret_cast<std::uintptr_t>(child.memory()));
+    EXPECT("child.bytes", child.bytes() % alignof(segment_t) == 0 && child.bytes() <= 256);
+
+    // appended heap is aligned too
+    void* blocks[4] = {};
+    for (auto& block : blocks)
+    {
+        block = child.add_segment(120);
+        ASSERT("child.add_segment", block != nullptr);
+        EXPECT("child.add_segment.alignment", reinterpret_cast<std::uintptr_t>(block) % alignof(segment_t) == 0);
+    }
+}
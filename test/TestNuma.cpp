@@ -0,0 +1,92 @@
+#include <EightmoryTestingBase.hpp>
+
+#include <Eightmory/Numa.hpp>
+
+#include <thread> // thread
+#include <vector> // vector
+
+using eightmory::numa_arenas_t;
+using eightmory::numa_node_count;
+using eightmory::current_numa_node;
+
+TEST(TestNuma, TestArenas)
+{
+    auto arenas = numa_arenas_t();
+    ASSERT("arenas.create", arenas.create(64 * 1024));
+
+    // single node system degrades to one arena
+    EXPECT("arenas.arena_count", arenas.arena_count() == numa_node_count() && arenas.arena_count() >= 1);
+    EXPECT("arenas.local_arena", arenas.local_arena() < arenas.arena_count());
+    EXPECT("arenas.node", arenas.node(arenas.local_arena()) == current_numa_node() || numa_node_count() == 1);
+
+    auto memory = arenas.add_segment(128);
+    ASSERT("arenas.add_segment", memory != nullptr);
+    EXPECT("arenas.arena_of", arenas.arena_of(memory) == arenas.local_arena());
+    EXPECT("arenas.extend_segment", arenas.extend_segment(memory, 64));
+    EXPECT("arenas.remove_segment", arenas.remove_segment(memory));
+
+    int outside = 0;
+    EXPECT("arenas.arena_of.outside", arenas.arena_of(&outside) == numa_arenas_t::npos);
+    EXPECT("arenas.remove_segment.outside", !arenas.remove_segment(&outside));
+
+    // explicit arena, free from any thread returns memory to it
+    auto last = arenas.arena_count() - 1;
+    auto remote = arenas.add_segment(256, last);
+    ASSERT("arenas.add_segment.arena", remote != nullptr && arenas.arena_of(remote) == last);
+    EXPECT("arenas.add_segment.invalid", arenas.add_segment(256, arenas.arena_count()) == nullptr);
+
+    auto is_removed = false;
+    std::thread([&] { is_removed = arenas.remove_segment(remote); }).join();
+    EXPECT("arenas.remove_segment.thread", is_removed);
+
+    arenas.close();
+    EXPECT("arenas.close", arenas.arena_count() == 0 && arenas.add_segment(8) == nullptr);
+}
+
+TEST(TestNuma, TestFallback)
+{
+    auto arenas = numa_arenas_t();
+    ASSERT("arenas.create", arenas.create(4096));
+
+    // full local arena is not a failure while other arenas have memory
+    std::vector<void*> blocks;
+    for (void* memory = arenas.add_segment(1024); memory != nullptr; memory = arenas.add_segment(1024))
+    {
+        blocks.push_back(memory);
+    }
+    EXPECT("arenas.fallback", blocks.size() >= 3 * arenas.arena_count());
+
+    for (auto memory : blocks)
+    {
+        EXPECT("arenas.remove_segment", arenas.remove_segment(memory));
+    }
+}
+
+TEST(TestNuma, TestConcurrent)
+{
+    auto arenas = numa_arenas_t();
+    ASSERT("arenas.create", arenas.create(256 * 1024));
+
+    std::vector<std::thread> threads;
+    std::vector<int> failures(4, 0);
+    for (std::size_t thread = 0; thread < failures.size(); ++thread)
+    {
+        threads.emplace_back([&arenas, &failures, thread]
+        {
+            void* blocks[16] = {};
+            for (std::size_t round = 0; round < 1000; ++round)
+            {
+                for (auto& block : blocks) failures[thread] += (block = arenas.add_segment(32 + round % 64)) == nullptr;
+                for (auto block : blocks) failures[thread] += !arenas.remove_segment(block);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    auto failure_count = 0;
+    for (auto failure : failures) failure_count += failure;
+    EXPECT("arenas.concurrent", failure_count == 0);
+}
@@ -0,0 +1,106 @@
+#include <EightmoryTestingBase.hpp>
+
+#include <Eightmory/Oom.hpp>
+
+using eightmory::segment_t;
+using eightmory::segment_manager_t;
+using eightmory::oom_segment_manager_t;
+
+TEST_SPACE()
+{
+
+// cache of releasable memory, like decoded assets
+struct cache_t
+{
+    oom_segment_manager_t* manager = nullptr;
+    void* memory = nullptr;
+    std::size_t call_count = 0;
+};
+
+bool release_cache(void* context, std::size_t) noexcept
+{
+    auto cache = static_cast<cache_t*>(context);
+    ++cache->call_count;
+    if (cache->memory == nullptr)
+    {
+        return false;
+    }
+
+    cache->manager->remove_segment(cache->memory);
+    cache->memory = nullptr;
+    return true;
+}
+
+} // TEST_SPACE
+
+TEST(TestOom, TestCoalesce)
+{
+    char memory[256];
+    auto manager = segment_manager_t(memory, sizeof(memory));
+
+    auto lhs = manager.add_segment(32);
+    auto rhs = manager.add_segment(32);
+    auto rest = manager.add_segment(sizeof(memory) - 3 * sizeof(segment_t) - 64);
+    ASSERT("manager.add_segment", lhs != nullptr && rhs != nullptr && rest != nullptr);
+
+    manager.remove_segment(lhs);
+    manager.remove_segment(rhs);
+
+    // search from rhs cannot see free lhs
+    EXPECT("manager.add_segment.fake_oom", manager.add_segment(64, segment_t::segment(rhs)) == nullptr);
+    EXPECT("manager.coalesce", manager.coalesce() == 64 + sizeof(segment_t));
+    EXPECT("manager.coalesce.idempotent", manager.coalesce() == 64 + sizeof(segment_t));
+}
+
+TEST(TestOom, TestRecover)
+{
+    char memory[256];
+    auto manager = oom_segment_manager_t(memory, sizeof(memory));
+
+    auto lhs = manager.add_segment(32);
+    auto rhs = manager.add_segment(32);
+    auto rest = manager.add_segment(sizeof(memory) - 3 * sizeof(segment_t) - 64);
+    ASSERT("manager.add_segment", lhs != nullptr && rhs != nullptr && rest != nullptr);
+
+    manager.remove_segment(lhs);
+    manager.remove_segment(rhs);
+
+    // coalesce pass turns fake out of memory into allocation
+    auto merged = manager.add_segment(64, segment_t::segment(rhs));
+    EXPECT("manager.add_segment.recovered", merged == lhs);
+    EXPECT("manager.counts", manager.coalesce_count() == 1 && manager.recovered_count() == 1 && manager.failure_count() == 0);
+
+    // real out of memory without callback
+    EXPECT("manager.add_segment.failure", manager.add_segment(64) == nullptr && manager.failure_count() == 1);
+}
+
+TEST(TestOom, TestReclaim)
+{
+    char memory[512];
+    auto manager = oom_segment_manager_t(memory, sizeof(memory));
+
+    auto cache = cache_t{&manager};
+    manager.set_reclaim(&release_cache, &cache);
+
+    cache.memory = manager.add_segment(128);
+    auto used = manager.add_segment(sizeof(memory) - 2 * sizeof(segment_t) - 128);
+    ASSERT("manager.add_segment", cache.memory != nullptr && used != nullptr);
+
+    // callback releases cache, then allocation is retried once
+    auto frame = manager.add_segment(100);
+    EXPECT("manager.add_segment.reclaim", frame != nullptr && cache.memory == nullptr && cache.call_count == 1);
+    EXPECT("manager.reclaim_count", manager.reclaim_count() == 1 && manager.recovered_count() == 1);
+
+    // nothing to release, so failure is real
+    EXPECT("manager.add_segment.failure", manager.add_segment(100) == nullptr && manager.failure_count() == 1);
+    EXPECT("manager.reclaim_count.failure", cache.call_count == 2);
+
+    // extend is retried after callback too
+    manager.remove_segment(frame);
+    auto block = manager.add_segment(32);
+    cache.memory = manager.add_segment(64);
+    ASSERT("manager.add_segment.block", block != nullptr && cache.memory != nullptr);
+
+    EXPECT("manager.extend_segment.reclaim", manager.extend_segment(block, 64) && cache.memory == nullptr);
+    EXPECT("manager.extend_segment.size", segment_t::segment(block)->size >= 96);
+}
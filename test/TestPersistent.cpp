@@ -0,0 +1,120 @@
+#include <EightmoryTestingBase.hpp>
+
+#include <Eightmory/Persistent.hpp>
+
+#include <cstdio> // fopen, remove
+#include <cstring> // strcmp, strcpy
+
+using eightmory::segment_t;
+using eightmory::persistent_header_t;
+using eightmory::persistent_segment_manager_t;
+
+static const char* persistent_path = "EightmoryTestPersistent.bin";
+
+TEST(TestPersistent, TestCreateAndReopen)
+{
+    static const auto heap_size = 256;
+    static const char message[] = "persistent";
+
+    auto writer = persistent_segment_manager_t();
+    ASSERT("writer.create", writer.create(persistent_path, heap_size) == true);
+    EXPECT("writer.manager.bytes", writer.manager().bytes() == heap_size);
+    EXPECT("writer.root", writer.root() == nullptr);
+
+    auto message_memory = writer.manager().add_segment(sizeof(message));
+    ASSERT("writer.add_segment", message_memory != nullptr);
+    std::strcpy(static_cast<char*>(message_memory), message);
+    writer.root(message_memory);
+
+    auto const message_offset = writer.offset(message_memory);
+    EXPECT("writer.offset", writer.memory(message_offset) == message_memory);
+    EXPECT("writer.flush", writer.flush() == true);
+
+    // second mapping of same file is placed at another address
+    auto reader = persistent_segment_manager_t();
+    ASSERT("reader.open", reader.open(persistent_path) == true);
+    EXPECT("reader.is_recovered", reader.is_recovered() == false);
+    EXPECT("reader.manager.begin", reader.manager().begin() != writer.manager().begin());
+    EXPECT("reader.manager.bytes", reader.manager().bytes() == heap_size);
+
+    auto root = static_cast<char*>(reader.root());
+    ASSERT("reader.root", root != nullptr);
+    EXPECT("reader.root.offset", reader.offset(root) == message_offset);
+    EXPECT("reader.root.message", std::strcmp(root, message) == 0);
+
+    auto root_segment = segment_t::segment(root);
+    EXPECT("reader.root.segment.size", root_segment->size == sizeof(message));
+    EXPECT("reader.root.segment.is_used", root_segment->is_used == true);
+
+    reader.close();
+    writer.close();
+    EXPECT("writer.close", writer.is_open() == false);
+
+
+    // reopen after close and continue allocation
+    ASSERT("reader.reopen", reader.open(persistent_path) == true);
+    EXPECT("reader.reopen.root", std::strcmp(static_cast<char*>(reader.root()), message) == 0);
+
+    auto other_memory = reader.manager().add_segment(16);
+    ASSERT("reader.reopen.add_segment", other_memory != nullptr);
+    EXPECT("reader.reopen.add_segment.order", reader.offset(other_memory) > message_offset);
+
+    reader.close();
+    std::remove(persistent_path);
+}
+
+TEST(TestPersistent, TestRecovery)
+{
+    static const auto heap_size = 128;
+
+    {
+        auto writer = persistent_segment_manager_t();
+        ASSERT("writer.create", writer.create(persistent_path, heap_size) == true);
+        ASSERT("writer.add_segment", writer.manager().add_segment(16) != nullptr);
+    }
+
+    // corrupt size of second segment: [8 + 16] (8 + 96)
+    {
+        auto file = std::fopen(persistent_path, "r+b");
+        ASSERT("file.open", file != nullptr);
+
+        auto broken = segment_t{};
+        broken.size = heap_size;
+        broken.is_used = true;
+
+        std::fseek(file, sizeof(persistent_header_t) + sizeof(segment_t) + 16, SEEK_SET);
+        std::fwrite(&broken, sizeof(broken), 1, file);
+        std::fclose(file);
+    }
+
+    auto reader = persistent_segment_manager_t();
+    ASSERT("reader.open", reader.open(persistent_path) == true);
+    EXPECT("reader.is_recovered", reader.is_recovered() == true);
+
+    auto used_segment = reader.manager().begin();
+    EXPECT("reader.used_segment", used_segment->size == 16 && used_segment->is_used == true);
+
+    auto recovered_segment = used_segment->next();
+    EXPECT("reader.recovered_segment", recovered_segment->size == 96 && recovered_segment->is_used == false);
+    EXPECT("reader.recovered_segment.next", recovered_segment->next() == reader.manager().end());
+
+    reader.close();
+    std::remove(persistent_path);
+}
+
+TEST(TestPersistent, TestInvalidFile)
+{
+    {
+        auto file = std::fopen(persistent_path, "wb");
+        ASSERT("file.open", file != nullptr);
+        std::fputs("not a heap", file);
+        std::fclose(file);
+    }
+
+    auto reader = persistent_segment_manager_t();
+    EXPECT("reader.open.invalid", reader.open(persistent_path) == false);
+    EXPECT("reader.is_open", reader.is_open() == false);
+
+    std::remove(persistent_path);
+    EXPECT("reader.open.missing", reader.open(persistent_path) == false);
+}
@@ -0,0 +1,145 @@
+#include <EightmoryTestingBase.hpp>
+
+#include <Eightmory/Pool.hpp>
+
+#include <atomic> // atomic
+#include <thread> // thread
+#include <vector> // vector
+
+using eightmory::segment_manager_t;
+
+using eightmory::fixed_pool_t;
+using eightmory::fixed_pool_cache_t;
+
+TEST_SPACE()
+{
+
+// pop all chains and count blocks
+std::size_t free_block_count(fixed_pool_t& pool) noexcept
+{
+    auto count = std::size_t(0);
+    for (auto first = pool.pop_chain(); first != fixed_pool_t::npos; first = pool.pop_chain())
+    {
+        for (auto index = first; index != fixed_pool_t::npos; index = pool.next_block(index))
+        {
+            ++count;
+        }
+    }
+    return count;
+}
+
+} // TEST_SPACE
+
+TEST(TestPool, TestPool)
+{
+    char memory[1024];
+    auto manager = segment_manager_t(memory, sizeof(memory));
+
+    auto const bytes = fixed_pool_t::bytes_for(12, 16);
+    auto segment_memory = manager.add_segment(bytes);
+    ASSERT("manager.add_segment", segment_memory != nullptr);
+
+    // block size is aligned up to 8
+    auto pool = fixed_pool_t(segment_memory, bytes, 12, 4);
+    EXPECT("pool.block_size", pool.block_size() == 16);
+    EXPECT("pool.block_count", pool.block_count() == 16);
+
+    void* blocks[16] = {};
+    for (auto& block : blocks)
+    {
+        block = pool.allocate();
+    }
+    EXPECT("pool.allocate.order", blocks[0] == pool.block(0) && blocks[5] == pool.block(5) && blocks[15] == pool.block(15));
+    EXPECT("pool.allocate.empty", pool.allocate() == nullptr);
+
+    pool.deallocate(blocks[3]);
+    EXPECT("pool.allocate.reuse", pool.allocate() == blocks[3]);
+
+    for (auto block : blocks)
+    {
+        pool.deallocate(block);
+    }
+    EXPECT("pool.free_block_count", free_block_count(pool) == 16);
+}
+
+TEST(TestPool, TestCache)
+{
+    char memory[1024];
+    auto pool = fixed_pool_t(memory, sizeof(memory), 8, 4);
+    auto const block_count = pool.block_count();
+
+    {
+        auto cache = fixed_pool_cache_t(pool);
+
+        // cache takes whole chain from pool
+        auto some_block = cache.allocate();
+        ASSERT("cache.allocate", some_block != nullptr);
+        EXPECT("cache.count", cache.count() == 3);
+
+        // keeps up to two batches, returns older blocks to pool
+        std::vector<void*> blocks;
+        for (std::size_t index = 0; index < 8; ++index)
+        {
+            blocks.push_back(cache.allocate());
+        }
+        for (auto block : blocks)
+        {
+            cache.deallocate(block);
+        }
+        EXPECT("cache.count.release", cache.count() < 2 * pool.batch_size());
+
+        // recently freed block stays in cache
+        auto hot_block = cache.allocate();
+        EXPECT("cache.allocate.hot", hot_block == blocks.back());
+        cache.deallocate(hot_block);
+
+        cache.deallocate(some_block);
+    }
+    EXPECT("pool.free_block_count", free_block_count(pool) == block_count);
+}
+
+TEST(TestPool, TestConcurrentCache)
+{
+    auto const thread_count = std::size_t(4);
+    auto const block_count = std::size_t(256);
+
+    std::vector<char> memory(fixed_pool_t::bytes_for(16, block_count));
+    auto pool = fixed_pool_t(memory.data(), memory.size(), 16, 8);
+
+    std::atomic<bool> is_valid{true};
+    std::vector<std::thread> threads;
+    for (std::size_t thread = 0; thread < thread_count; ++thread)
+    {
+        threads.emplace_back([&pool, &is_valid, thread]
+        {
+            auto cache = fixed_pool_cache_t(pool);
+            std::vector<std::size_t*> blocks;
+            for (std::size_t round = 0; round < 2000; ++round)
+            {
+                for (std::size_t count = 0; count < 1 + (round + thread) % 48; ++count)
+                {
+                    auto block = static_cast<std::size_t*>(round % 3 == 0 ? pool.allocate() : cache.allocate());
+                    if (block == nullptr) break;
+
+                    block[1] = thread;
+                    blocks.push_back(block);
+                }
+
+                // block owned by other thread means it was allocated twice
+                for (auto block : blocks)
+                {
+                    if (block[1] != thread) is_valid = false;
+                    round % 2 == 0 ? cache.deallocate(block) : pool.deallocate(block);
+                }
+                blocks.clear();
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT("pool.concurrent.is_valid", is_valid == true);
+    EXPECT("pool.concurrent.free_block_count", free_block_count(pool) == block_count);
+}
@@ -0,0 +1,125 @@
+#include <EightmoryTestingBase.hpp>
+
+#include <Eightmory/Profiler.hpp>
+
+#include <cstdio> // remove, fopen, fgets
+#include <cstring> // strncmp
+
+using eightmory::heap_profiler_t;
+using eightmory::profiled_segment_manager_t;
+
+static const char* profile_path = "EightmoryTestProfile.heap";
+
+TEST(TestProfiler, TestSampleEachAllocation)
+{
+    char memory[256];
+    auto manager = profiled_segment_manager_t(memory, sizeof(memory));
+
+    // any allocation is greater than mean distance
+    manager.hooks().set_sample_period(1);
+
+    auto some_memory = manager.add_segment(16);
+    auto other_memory = manager.add_segment(32);
+    ASSERT("manager.add_segment", some_memory != nullptr && other_memory != nullptr);
+
+    auto const& profiler = manager.hooks();
+    EXPECT("profiler.live_samples", profiler.live_samples() == 2);
+
+    auto inuse_bytes = std::size_t(0);
+    auto alloc_count = std::size_t(0);
+    for (auto const& bucket : profiler.buckets())
+    {
+        inuse_bytes += bucket.inuse_bytes;
+        alloc_count += bucket.alloc_count;
+    }
+    EXPECT("profiler.inuse_bytes", inuse_bytes == 48);
+    EXPECT("profiler.alloc_count", alloc_count == 2);
+
+    manager.remove_segment(some_memory);
+    manager.extend_segment(other_memory, 8);
+    EXPECT("profiler.live_samples.free", profiler.live_samples() == 1);
+
+    inuse_bytes = 0;
+    auto alloc_bytes = std::size_t(0);
+    for (auto const& bucket : profiler.buckets())
+    {
+        inuse_bytes += bucket.inuse_bytes;
+        alloc_bytes += bucket.alloc_bytes;
+    }
+    EXPECT("profiler.inuse_bytes.free", inuse_bytes == 40);
+    EXPECT("profiler.alloc_bytes", alloc_bytes == 56);
+}
+
+TEST(TestProfiler, TestSamplingRate)
+{
+    auto profiler = heap_profiler_t(1024);
+
+    // one sample per 1024 bytes in average
+    auto const count = std::size_t(100000);
+    for (std::size_t index = 0; index < count; ++index)
+    {
+        profiler.allocate(reinterpret_cast<void*>((index + 1) * 16), 16, 0);
+    }
+
+    auto const expected = count * 16 / 1024;
+    EXPECT("profiler.live_samples", profiler.live_samples() > expected * 9 / 10 && profiler.live_samples() < expected * 11 / 10);
+
+    profiler.set_sample_period(0);
+    profiler.reset();
+    for (std::size_t index = 0; index < count; ++index)
+    {
+        profiler.allocate(reinterpret_cast<void*>((index + 1) * 16), 16, 0);
+    }
+    EXPECT("profiler.disabled", profiler.live_samples() == 0 && profiler.buckets().empty());
+}
+
+TEST(TestProfiler, TestResample)
+{
+    auto profiler = heap_profiler_t(1);
+    profiler.allocate(reinterpret_cast<void*>(64), 100, 0);
+
+    // memory released without free hook is sampled again, so old sample must not stay in use
+    profiler.allocate(reinterpret_cast<void*>(64), 40, 0);
+
+    auto inuse_count = std::size_t(0);
+    auto inuse_bytes = std::size_t(0);
+    auto alloc_count = std::size_t(0);
+    for (auto const& bucket : profiler.buckets())
+    {
+        inuse_count += bucket.inuse_count;
+        inuse_bytes += bucket.inuse_bytes;
+        alloc_count += bucket.alloc_count;
+    }
+    EXPECT("profiler.live_samples", profiler.live_samples() == 1);
+    EXPECT("profiler.inuse", inuse_count == 1 && inuse_bytes == 40 && alloc_count == 2);
+
+    profiler.free(reinterpret_cast<void*>(64), 40, 0);
+
+    inuse_count = 0;
+    for (auto const& bucket : profiler.buckets())
+    {
+        inuse_count += bucket.inuse_count;
+    }
+    EXPECT("profiler.free", profiler.live_samples() == 0 && inuse_count == 0);
+}
+
+TEST(TestProfiler, TestWriteHeapProfile)
+{
+    auto profiler = heap_profiler_t(1);
+    profiler.allocate(reinterpret_cast<void*>(64), 100, 0);
+    profiler.allocate(reinterpret_cast<void*>(256), 28, 0);
+    profiler.free(reinterpret_cast<void*>(256), 28, 0);
+
+    ASSERT("profiler.write_heap_profile", profiler.write_heap_profile(profile_path) == true);
+
+    auto file = std::fopen(profile_path, "r");
+    ASSERT("fopen", file != nullptr);
+
+    char line[256] = {};
+    auto const has_line = std::fgets(line, sizeof(line), file) != nullptr;
+    std::fclose(file);
+    std::remove(profile_path);
+
+    ASSERT("profile.header", has_line);
+    EXPECT("profile.header.totals", std::strncmp(line, "heap profile:      1:      100 [     2:      128] @ heap_v2/1\n", sizeof(line)) == 0);
+}
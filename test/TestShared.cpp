@@ -0,0 +1,161 @@
+#include <EightmoryTestingBase.hpp>
+
+#include <Eightmory/Shared.hpp>
+
+#include <cstring> // strcmp, strcpy
+#include <thread> // thread
+#include <vector> // vector
+
+#ifndef _WIN32
+#include <sys/wait.h> // waitpid
+#include <unistd.h> // fork, _exit
+#endif // _WIN32
+
+using eightmory::segment_t;
+using eightmory::shared_segment_manager_t;
+
+static const char* shared_name = "EightmoryTestShared";
+
+TEST(TestShared, TestCreateAndOpen)
+{
+    static const auto heap_size = 256;
+    static const char message[] = "shared";
+
+    shared_segment_manager_t::remove(shared_name);
+
+    auto owner = shared_segment_manager_t();
+    ASSERT("owner.create", owner.create(shared_name, heap_size) == true);
+    EXPECT("owner.create.again", shared_segment_manager_t().create(shared_name, heap_size) == false);
+
+    auto other = shared_segment_manager_t();
+    ASSERT("other.open", other.open(shared_name) == true);
+    EXPECT("other.manager.bytes", other.manager().bytes() == heap_size);
+
+    // pointers are exchanged as offsets
+    auto message_memory = owner.add_segment(sizeof(message));
+    ASSERT("owner.add_segment", message_memory != nullptr);
+    std::strcpy(static_cast<char*>(message_memory), message);
+
+    auto other_message = static_cast<char*>(other.memory(owner.offset(message_memory)));
+    EXPECT("other.memory.message", std::strcmp(other_message, message) == 0);
+    EXPECT("other.memory.segment", segment_t::segment(other_message)->is_used == true);
+
+    // in place allocation and removing from other side
+    auto other_memory = other.add_segment(16);
+    ASSERT("other.add_segment", other_memory != nullptr);
+    EXPECT("owner.offset.order", other.offset(other_memory) > owner.offset(message_memory));
+
+    EXPECT("other.remove_segment", other.remove_segment(other_message) == true);
+    EXPECT("owner.remove_segment.is_used", segment_t::segment(message_memory)->is_used == false);
+
+    EXPECT("owner.memory.npos", owner.memory(shared_segment_manager_t::npos) == nullptr);
+    EXPECT("owner.offset.nullptr", owner.offset(nullptr) == shared_segment_manager_t::npos);
+
+    other.close();
+    owner.close();
+    shared_segment_manager_t::remove(shared_name);
+}
+
+TEST(TestShared, TestConcurrentAccess)
+{
+    static const auto heap_size = 64 * 1024;
+    static const auto thread_count = 4;
+    static const auto iteration_count = 1000;
+
+    shared_segment_manager_t::remove(shared_name);
+
+    auto owner = shared_segment_manager_t();
+    ASSERT("owner.create", owner.create(shared_name, heap_size) == true);
+
+    std::vector<std::thread> threads;
+    std::vector<int> failures(thread_count, 0);
+    for (auto index = 0; index < thread_count; ++index)
+    {
+        threads.emplace_back([index, &failures]
+        {
+            auto other = shared_segment_manager_t();
+            if (!other.open(shared_name))
+            {
+                failures[index] = iteration_count;
+                return;
+            }
+
+            for (auto iteration = 0; iteration < iteration_count; ++iteration)
+            {
+                auto memory = static_cast<unsigned char*>(other.add_segment(32));
+                if (memory == nullptr)
+                {
+                    ++failures[index];
+                    continue;
+                }
+
+                std::memset(memory, index, 32);
+                for (auto byte = 0; byte < 32; ++byte)
+                {
+                    failures[index] += memory[byte] != index;
+                }
+                other.remove_segment(memory);
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    auto failure_count = 0;
+    for (auto failure : failures)
+    {
+        failure_count += failure;
+    }
+    EXPECT("owner.concurrent.failures", failure_count == 0);
+
+    auto segment_count = std::size_t(0);
+    for (auto segment = owner.manager().begin(); segment != owner.manager().end(); segment = segment->next())
+    {
+        segment_count += segment->is_used;
+    }
+    EXPECT("owner.concurrent.used_segments", segment_count == 0);
+
+    owner.close();
+    shared_segment_manager_t::remove(shared_name);
+}
+
+#ifndef _WIN32
+TEST(TestShared, TestDeadOwner)
+{
+    shared_segment_manager_t::remove(shared_name);
+
+    auto owner = shared_segment_manager_t();
+    ASSERT("owner.create", owner.create(shared_name, 256) == true);
+
+    // process dies while holding lock
+    auto const child = fork();
+    ASSERT("fork", child != -1);
+    if (child == 0)
+    {
+        auto other = shared_segment_manager_t();
+        if (other.open(shared_name))
+        {
+            other.lock();
+        }
+        _exit(0);
+    }
+
+    int status = 0;
+    waitpid(child, &status, 0);
+    ASSERT("child.exit", WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+    // lock of died process is taken over instead of deadlock
+    auto memory = owner.add_segment(16);
+    EXPECT("owner.add_segment", memory != nullptr);
+    EXPECT("owner.dead_owner_count", owner.dead_owner_count() == 1);
+
+    // lock is released as usual after take over
+    EXPECT("owner.remove_segment", owner.remove_segment(memory) && owner.dead_owner_count() == 1);
+
+    owner.close();
+    shared_segment_manager_t::remove(shared_name);
+}
+#endif // _WIN32
@@ -0,0 +1,75 @@
+#include <EightmoryTestingBase.hpp>
+
+#include <Eightmory/Static.hpp>
+
+using eightmory::segment_t;
+using eightmory::static_segment_manager_t;
+
+TEST_SPACE()
+{
+
+// (8 + 56) -> [8 + 16] [8 + 8] (8 + 16)
+constexpr auto make_startup_pool() noexcept
+{
+    static_segment_manager_t<64> pool;
+    [[maybe_unused]] auto const render_offset = pool.add_segment(16);
+    [[maybe_unused]] auto const audio_offset = pool.add_segment(8);
+    return pool;
+}
+
+constexpr auto startup_pool = make_startup_pool();
+
+static_assert(startup_pool.begin() == 8);
+static_assert(startup_pool.segment_size(8) == 16 && startup_pool.segment_is_used(8));
+static_assert(startup_pool.next(8) == 32);
+static_assert(startup_pool.segment_size(32) == 8 && startup_pool.segment_is_used(32));
+static_assert(startup_pool.next(32) == 48);
+static_assert(startup_pool.segment_size(48) == 16 && !startup_pool.segment_is_used(48));
+static_assert(startup_pool.next(48) == static_segment_manager_t<64>::npos);
+
+// lazy defragmentation and extending at compile-time
+static_assert([]
+{
+    static_segment_manager_t<64> pool;
+    auto const first = pool.add_segment(8);
+    auto const second = pool.add_segment(8);
+    pool.remove_segment(first);
+    pool.remove_segment(second);
+
+    // (8 + 8) (8 + 8) (8 + 24) -> [8 + 40] (8 + 8) -> [8 + 56]
+    auto const merged = pool.add_segment(40);
+    return merged == first && pool.segment_size(merged) == 40 && pool.extend_segment(merged) && pool.segment_size(merged) == 56;
+}());
+
+// embedded in binary, no run-time initialization
+constinit static_segment_manager_t<64> runtime_pool = make_startup_pool();
+
+} // TEST_SPACE
+
+TEST(TestStatic, TestRuntimeManager)
+{
+    auto render_memory = runtime_pool.memory(8);
+    auto audio_memory = runtime_pool.memory(32);
+
+    // compile-time layout is valid for segment_manager_t
+    auto manager = runtime_pool.manager();
+    ASSERT("manager.bytes", manager.bytes() == 64);
+
+    auto render_segment = segment_t::segment(render_memory);
+    EXPECT("manager.render_segment", manager.begin() == render_segment && render_segment->size == 16 && render_segment->is_used == true);
+
+    auto audio_segment = segment_t::segment(audio_memory);
+    EXPECT("manager.audio_segment", render_segment->next() == audio_segment && audio_segment->size == 8 && audio_segment->is_used == true);
+
+    auto free_segment = audio_segment->next();
+    EXPECT("manager.free_segment", free_segment->size == 16 && free_segment->is_used == false && free_segment->next() == manager.end());
+
+    // [8 + 16] [8 + 8] [8 + 16]
+    auto memory = manager.add_segment(16);
+    EXPECT("manager.add_segment", memory == free_segment->memory());
+    EXPECT("runtime_pool.segment_is_used", runtime_pool.segment_is_used(48) == true);
+
+    // run-time changes are visible for static manager
+    EXPECT("manager.remove_segment", manager.remove_segment(audio_memory) == true);
+    EXPECT("runtime_pool.segment_is_used", runtime_pool.segment_is_used(32) == false);
+}
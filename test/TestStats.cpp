@@ -0,0 +1,219 @@
+#include <EightmoryTestingBase.hpp>
+
+#include <Eightmory/Stats.hpp>
+
+#include <cstdlib> // rand, srand
+#include <vector> // vector
+
+using eightmory::segment_t;
+using eightmory::segment_stats_t;
+using eightmory::stats_segment_manager_t;
+
+static_assert(sizeof(eightmory::segment_manager_t) == 2 * sizeof(segment_t*) + debug_manager_bytes, "Disabled stats must not take memory.");
+
+TEST_SPACE()
+{
+
+// stats computed by full walk
+segment_stats_t segment_walk_stats(stats_segment_manager_t& manager) noexcept
+{
+    segment_stats_t stats;
+    stats.init(manager.begin(), manager.end());
+    return stats;
+}
+
+bool is_same_state(segment_stats_t const& lhs, segment_stats_t const& rhs) noexcept
+{
+    return lhs.used_bytes == rhs.used_bytes && lhs.free_bytes == rhs.free_bytes
+        && lhs.used_segments == rhs.used_segments && lhs.free_segments == rhs.free_segments
+        && lhs.largest_free == rhs.largest_free && lhs.largest_free_count == rhs.largest_free_count
+        && lhs.free_histogram == rhs.free_histogram;
+}
+
+} // TEST_SPACE
+
+TEST(TestStats, TestCommon)
+{
+    // (8 + 56)
+    char memory[64];
+    auto manager = stats_segment_manager_t(memory, sizeof(memory));
+
+    auto stats = manager.snapshot();
+    EXPECT("manager.stats", stats.free_bytes == 56 && stats.free_segments == 1 && stats.largest_free == 56);
+
+    // [8 + 8] [8 + 8] (8 + 24)
+    auto first_memory = manager.add_segment(8);
+    auto second_memory = manager.add_segment(8);
+    ASSERT("manager.add_segment", first_memory != nullptr && second_memory != nullptr);
+
+    stats = manager.snapshot();
+    EXPECT("manager.add_segment.bytes", stats.used_bytes == 16 && stats.free_bytes == 24);
+    EXPECT("manager.add_segment.segments", stats.used_segments == 2 && stats.free_segments == 1);
+    EXPECT("manager.add_segment.split_count", stats.split_count == 2);
+    EXPECT("manager.add_segment.visit_count", stats.visit_count == 3 && stats.last_visit_count == 2 && stats.max_visit_count == 2);
+    EXPECT("manager.add_segment.largest_free", stats.largest_free == 24);
+
+    // (8 + 8) (8 + 8) (8 + 24)
+    manager.remove_segment(first_memory);
+    manager.remove_segment(second_memory);
+
+    stats = manager.snapshot();
+    EXPECT("manager.remove_segment", stats.used_bytes == 0 && stats.free_bytes == 40 && stats.free_segments == 3);
+
+    // [8 + 56]
+    auto whole_memory = manager.add_segment(56);
+    ASSERT("manager.add_segment.whole", whole_memory == first_memory);
+
+    stats = manager.snapshot();
+    EXPECT("manager.add_segment.whole.merge_count", stats.merge_count == 2);
+    EXPECT("manager.add_segment.whole.bytes", stats.used_bytes == 56 && stats.free_bytes == 0);
+    EXPECT("manager.add_segment.whole.largest_free", stats.largest_free == 0);
+
+    EXPECT("manager.add_segment.fail", manager.add_segment(1) == nullptr);
+    EXPECT("manager.add_segment.failure_count", manager.stats().failure_count == 1);
+}
+
+TEST(TestStats, TestConsistency)
+{
+    char memory[4096];
+    auto manager = stats_segment_manager_t(memory, sizeof(memory));
+
+    std::srand(8);
+    std::vector<void*> memories;
+
+    bool success = true;
+    for (auto iteration = 0; iteration < 2000; ++iteration)
+    {
+        auto const action = std::rand() % 4;
+        if (action == 0 && !memories.empty())
+        {
+            auto const index = std::rand() % memories.size();
+            manager.remove_segment(memories[index]);
+            memories.erase(memories.begin() + index);
+        }
+        else if (action == 1 && !memories.empty())
+        {
+            auto const index = std::rand() % memories.size();
+            if (std::rand() % 2)
+            {
+                manager.extend_segment(memories[index], std::rand() % 32);
+            }
+            else
+            {
+                manager.extend_segment(memories[index]);
+            }
+        }
+        else
+        {
+            auto memory = manager.add_segment(std::rand() % 64);
+            if (memory != nullptr)
+            {
+                memories.push_back(memory);
+            }
+        }
+
+        auto const walk_stats = segment_walk_stats(manager);
+
+        // without walk, largest free segment size is upper bound
+        auto const& stats = manager.stats();
+        success &= stats.largest_free >= walk_stats.largest_free;
+        success &= !stats.is_largest_free_exact || stats.largest_free == walk_stats.largest_free;
+        success &= !stats.is_largest_free_exact || stats.largest_free_count == walk_stats.largest_free_count;
+        success &= stats.fragmentation() <= walk_stats.fragmentation();
+
+        success &= is_same_state(manager.snapshot(), walk_stats);
+    }
+    EXPECT("manager.consistency", success == true);
+}
+
+TEST(TestStats, TestFragmentation)
+{
+    // (8 + 88)
+    char memory[96];
+    auto manager = stats_segment_manager_t(memory, sizeof(memory));
+
+    EXPECT("manager.fragmentation", manager.stats().fragmentation() == 0.0);
+    EXPECT("manager.free_histogram", manager.stats().free_histogram[segment_stats_t::bin(88)] == 1);
+
+    // (8 + 8) [8 + 8] (8 + 8) [8 + 8] (8 + 24)
+    void* memories[4];
+    for (auto& memory : memories)
+    {
+        memory = manager.add_segment(8);
+    }
+    manager.remove_segment(memories[0]);
+    manager.remove_segment(memories[2]);
+
+    auto const& stats = manager.stats();
+    EXPECT("manager.free_bytes", stats.free_bytes == 40);
+    EXPECT("manager.free_histogram.eight", stats.free_histogram[segment_stats_t::bin(8)] == 2);
+    EXPECT("manager.free_histogram.twenty_four", stats.free_histogram[segment_stats_t::bin(24)] == 1);
+    EXPECT("manager.largest_free", stats.largest_free == 24 && stats.is_largest_free_exact == true);
+    EXPECT("manager.fragmentation", stats.fragmentation() == 1.0 - 24.0 / 40.0);
+
+    // (8 + 8) [8 + 8] (8 + 8) [8 + 8] [8 + 24]
+    auto tail_memory = manager.add_segment(24);
+    ASSERT("manager.add_segment.tail", tail_memory != nullptr);
+
+    // largest free segment is bounded by histogram bin
+    EXPECT("manager.largest_free.bound", stats.largest_free == segment_stats_t::bin_max_size(segment_stats_t::bin(8)));
+    EXPECT("manager.largest_free.exact", manager.snapshot().largest_free == 8);
+}
+
+TEST(TestStats, TestLargestFree)
+{
+    // (8 + 1025) [8 + 8] (8 + 1025) [8 + 8] (8 + 1000) [8 + 8] (8 + 600) [8 + 8]
+    char memory[4 * (8 + 8) + 4 * 8 + 1025 + 1025 + 1000 + 600];
+    auto manager = stats_segment_manager_t(memory, sizeof(memory));
+
+    std::size_t const sizes[] = {1025, 1025, 1000, 600};
+    void* free_memories[4] = {};
+    for (std::size_t index = 0; index < 4; ++index)
+    {
+        free_memories[index] = manager.add_segment(sizes[index]);
+        ASSERT("manager.add_segment", free_memories[index] != nullptr && manager.add_segment(8) != nullptr);
+    }
+    for (auto memory : free_memories)
+    {
+        manager.remove_segment(memory);
+    }
+
+    auto const& stats = manager.stats();
+    EXPECT("manager.largest_free_count", stats.largest_free == 1025 && stats.largest_free_count == 2);
+
+    // other segment of same size is left, so value stays exact
+    auto first_memory = manager.add_segment(1025);
+    ASSERT("manager.add_segment.first", first_memory == free_memories[0]);
+    EXPECT("manager.largest_free.exact", stats.is_largest_free_exact && stats.largest_free == 1025 && stats.largest_free_count == 1);
+    EXPECT("manager.fragmentation", stats.fragmentation() == 1.0 - 1025.0 / 2625.0);
+
+    // last segment of largest size is used, so only bound of bin is known and fragmentation is lower bound
+    auto second_memory = manager.add_segment(1025);
+    ASSERT("manager.add_segment.second", second_memory == free_memories[1]);
+    EXPECT("manager.largest_free.bound", !stats.is_largest_free_exact && stats.largest_free == 1023);
+    EXPECT("manager.fragmentation.bound", stats.fragmentation() == 1.0 - 1023.0 / 1600.0);
+
+    auto const snapshot = manager.snapshot();
+    EXPECT("manager.snapshot", snapshot.is_largest_free_exact && snapshot.largest_free == 1000 && snapshot.fragmentation() == 1.0 - 1000.0 / 1600.0);
+}
+
+TEST(TestStats, TestExtendHeap)
+{
+    // [8 + 24] (8 + 24) | 64
+    char memory[128];
+    auto manager = stats_segment_manager_t(memory, 64);
+
+    auto used_memory = manager.add_segment(24);
+    ASSERT("manager.add_segment", used_memory != nullptr);
+
+    auto const before = manager.stats();
+
+    // [8 + 24] (8 + 24) (8 + 56)
+    ASSERT("manager.extend_heap", manager.extend_heap(64));
+
+    auto const& stats = manager.stats();
+    EXPECT("manager.extend_heap.free", stats.free_bytes == 24 + 56 && stats.free_segments == 2 && stats.largest_free == 56);
+    EXPECT("manager.extend_heap.used", stats.used_bytes == 24 && stats.used_segments == 1);
+    EXPECT("manager.extend_heap.lifetime", stats.add_count == before.add_count && stats.split_count == before.split_count && stats.visit_count == before.visit_count);
+    EXPECT("manager.extend_heap.consistency", is_same_state(manager.snapshot(), segment_walk_stats(manager)));
+}
@@ -0,0 +1,116 @@
+#include <EightmoryTestingBase.hpp>
+
+#include <Eightmory/Table.hpp>
+
+#include <cstring> // memset
+#include <vector> // vector
+#include <tuple> // tuple
+
+using eightmory::segment_entry_t;
+using eightmory::table_segment_manager_t;
+
+using eightmory::is_aligned;
+
+using entry_trace_t = std::vector<std::tuple<std::size_t, std::size_t, bool>>;
+
+TEST_SPACE()
+{
+
+entry_trace_t entry_trace(table_segment_manager_t const& manager)
+{
+    entry_trace_t trace;
+    for (auto entry = manager.begin(); entry != manager.end(); ++entry)
+    {
+        trace.emplace_back((std::size_t)entry->offset, (std::size_t)entry->size, (bool)entry->is_used);
+    }
+    return trace;
+}
+
+} // TEST_SPACE
+
+TEST(TestTable, TestCommon)
+{
+    alignas(64) char memory[128];
+    segment_entry_t entries[8];
+    auto manager = table_segment_manager_t(memory, sizeof(memory), entries, 8);
+
+
+    EXPECT("manager.trace", entry_trace(manager) == entry_trace_t{{0, 128, false}});
+
+    // [0, 16) (16, 128)
+    auto sixteen_size_memory = manager.add_segment(16);
+    ASSERT("manager.add_segment.sixteen_size_segment", sixteen_size_memory == memory);
+    EXPECT("manager.trace.sixteen_size_segment", entry_trace(manager) == entry_trace_t{{0, 16, true}, {16, 112, false}});
+
+    // [0, 16) (16, 32) [32, 40) (40, 128)
+    auto aligned_memory = manager.add_segment(8, 32);
+    ASSERT("manager.add_segment.aligned_segment", aligned_memory == memory + 32);
+    EXPECT("manager.add_segment.aligned_segment.is_aligned", is_aligned(reinterpret_cast<std::size_t>(aligned_memory), 32));
+    EXPECT("manager.trace.aligned_segment", entry_trace(manager) == entry_trace_t{{0, 16, true}, {16, 16, false}, {32, 8, true}, {40, 88, false}});
+
+    // user writes cannot damage metadata
+    std::memset(sixteen_size_memory, 0xFF, 16);
+    std::memset(aligned_memory, 0xFF, 8);
+
+    // [0, 16) [16, 20) (20, 32) [32, 40) (40, 128)
+    auto four_size_memory = manager.add_segment(4);
+    ASSERT("manager.add_segment.four_size_segment", four_size_memory == memory + 16);
+    EXPECT("manager.trace.four_size_segment", entry_trace(manager) == entry_trace_t{{0, 16, true}, {16, 4, true}, {20, 12, false}, {32, 8, true}, {40, 88, false}});
+
+    // [0, 16) [16, 20) (20, 32) [32, 56) (56, 128)
+    EXPECT("manager.extend_segment.aligned_segment", manager.extend_segment(aligned_memory, 16) == true);
+    EXPECT("manager.trace.extend_segment", entry_trace(manager) == entry_trace_t{{0, 16, true}, {16, 4, true}, {20, 12, false}, {32, 24, true}, {56, 72, false}});
+    EXPECT("manager.extend_segment.four_size_segment", manager.extend_segment(four_size_memory, 16) == false);
+
+
+    // (0, 16) [16, 20) (20, 32) [32, 56) (56, 128)
+    EXPECT("manager.remove_segment.sixteen_size_segment", manager.remove_segment(sixteen_size_memory) == true);
+    EXPECT("manager.remove_segment.sixteen_size_segment.again", manager.remove_segment(sixteen_size_memory) == false);
+    EXPECT("manager.remove_segment.inner", manager.remove_segment(memory + 33) == false);
+
+    // (0, 32) [32, 56) (56, 128)
+    EXPECT("manager.remove_segment.four_size_segment", manager.remove_segment(four_size_memory) == true);
+    EXPECT("manager.trace.four_size_segment", entry_trace(manager) == entry_trace_t{{0, 32, false}, {32, 24, true}, {56, 72, false}});
+
+    // (0, 128)
+    EXPECT("manager.remove_segment.aligned_segment", manager.remove_segment(aligned_memory) == true);
+    EXPECT("manager.trace.aligned_segment", entry_trace(manager) == entry_trace_t{{0, 128, false}});
+}
+
+TEST(TestTable, TestFullTable)
+{
+    char memory[64];
+    segment_entry_t entries[2];
+    auto manager = table_segment_manager_t(memory, sizeof(memory), entries, 2);
+
+    // [0, 8) (8, 64)
+    auto first_memory = manager.add_segment(8);
+    ASSERT("manager.add_segment.first_segment", first_memory != nullptr);
+
+    // rest memory is kept in segment: [0, 8) [8, 64)
+    auto second_memory = manager.add_segment(8);
+    ASSERT("manager.add_segment.second_segment", second_memory != nullptr);
+    EXPECT("manager.trace.second_segment", entry_trace(manager) == entry_trace_t{{0, 8, true}, {8, 56, true}});
+
+    EXPECT("manager.add_segment.full", manager.add_segment(1) == nullptr);
+
+    // zero size is one byte: (0, 8) [8, 64) -> [0, 1) (1, 8) [8, 64) is not possible, table is full
+    EXPECT("manager.remove_segment.first_segment", manager.remove_segment(first_memory) == true);
+    auto zero_size_memory = manager.add_segment(0);
+    ASSERT("manager.add_segment.zero_size_segment", zero_size_memory == first_memory);
+    EXPECT("manager.trace.zero_size_segment", entry_trace(manager) == entry_trace_t{{0, 8, true}, {8, 56, true}});
+}
+
+TEST(TestTable, TestInvalidManager)
+{
+    char memory[8];
+    segment_entry_t entries[1];
+
+    auto empty_memory_manager = table_segment_manager_t(memory, 0, entries, 1);
+    EXPECT("empty_memory_manager.count", empty_memory_manager.count() == 0);
+    EXPECT("empty_memory_manager.add_segment", empty_memory_manager.add_segment(0) == nullptr);
+
+    auto empty_table_manager = table_segment_manager_t(memory, sizeof(memory), entries, 0);
+    EXPECT("empty_table_manager.count", empty_table_manager.count() == 0);
+    EXPECT("empty_table_manager.remove_segment", empty_table_manager.remove_segment(memory) == false);
+}
@@ -0,0 +1,117 @@
+#include <EightmoryTestingBase.hpp>
+
+#include <Eightmory/Tags.hpp>
+#include <Eightmory/Dump.hpp>
+
+using eightmory::tagged_segment_t;
+using eightmory::tagged_segment_manager_t;
+
+using eightmory::segment_info_t;
+using eightmory::walk_segments;
+
+static_assert(sizeof(tagged_segment_t) == sizeof(eightmory::segment_t), "Tag must not take memory.");
+
+TEST_SPACE()
+{
+
+enum subsystem_t : std::uint32_t
+{
+    rendering = 1,
+    audio = 2,
+};
+
+} // TEST_SPACE
+
+TEST(TestTags, TestTaggedSegment)
+{
+    // [8 + 8] [8 + 16] (8 + 16)
+    char memory[64];
+    auto manager = tagged_segment_manager_t(memory, sizeof(memory));
+
+    auto rendering_memory = manager.add_segment(8, rendering);
+    auto audio_memory = manager.add_segment(16, audio);
+    ASSERT("manager.add_segment", rendering_memory != nullptr && audio_memory != nullptr);
+
+    EXPECT("manager.tag", manager.tag(rendering_memory) == rendering && manager.tag(audio_memory) == audio);
+    EXPECT("segment.size", tagged_segment_t::segment(audio_memory)->size == 16);
+    EXPECT("manager.live_bytes", manager.live_bytes(rendering) == 8 && manager.live_bytes(audio) == 16 && manager.live_bytes(0) == 0);
+
+    std::uint32_t tags[3] = {};
+    auto index = std::size_t(0);
+    walk_segments(manager.manager(), [&](segment_info_t const& info) { tags[index++] = info.tag; });
+    EXPECT("walk_segments.tag", tags[0] == rendering && tags[1] == audio && tags[2] == 0);
+
+    // [8 + 8] [8 + 24] (8 + 8)
+    EXPECT("manager.extend_segment", manager.extend_segment(audio_memory, 8) == true);
+    EXPECT("manager.extend_segment.tag", manager.tag(audio_memory) == audio && manager.live_bytes(audio) == 24);
+
+    EXPECT("manager.remove_segment", manager.remove_segment(rendering_memory) == true);
+    EXPECT("manager.live_bytes.remove", manager.live_bytes(rendering) == 0);
+
+    // [8 + 8] [8 + 40]
+    EXPECT("manager.extend_segment.all", manager.extend_segment(audio_memory) == true);
+    EXPECT("manager.live_bytes.extend", manager.live_bytes(audio) == 40);
+
+    EXPECT("manager.add_segment.invalid_tag", manager.add_segment(8, tagged_segment_manager_t::tag_count) == nullptr);
+}
+
+TEST(TestTags, TestBudget)
+{
+    char memory[256];
+    auto manager = tagged_segment_manager_t(memory, sizeof(memory));
+    manager.set_budget(audio, 32);
+
+    auto some_memory = manager.add_segment(24, audio);
+    ASSERT("manager.add_segment", some_memory != nullptr);
+
+    // fails before search, other tags are not affected
+    EXPECT("manager.add_segment.budget", manager.add_segment(16, audio) == nullptr);
+    EXPECT("manager.failure_count", manager.failure_count(audio) == 1);
+    EXPECT("manager.add_segment.other", manager.add_segment(64, rendering) != nullptr);
+
+    // worst case of extension is 8 + 8 - 1 bytes, it's over budget
+    EXPECT("manager.extend_segment.budget", manager.extend_segment(some_memory, 8) == false);
+    EXPECT("manager.live_bytes.budget", manager.live_bytes(audio) == 24);
+
+    EXPECT("manager.add_segment.fit", manager.add_segment(8, audio) != nullptr);
+    EXPECT("manager.live_bytes.fit", manager.live_bytes(audio) == 32);
+
+    manager.remove_segment(some_memory);
+    EXPECT("manager.add_segment.after_remove", manager.add_segment(16, audio) != nullptr);
+}
+
+TEST(TestTags, TestHooksTag)
+{
+    struct tag_hooks_t
+    {
+        std::uint32_t allocated = 0;
+        std::uint32_t freed = 0;
+
+        void allocate(void*, std::size_t, std::uint32_t tag) noexcept { allocated = tag; }
+        void free(void*, std::size_t, std::uint32_t tag) noexcept { freed = tag; }
+        void extend(void*, std::size_t, std::uint32_t) noexcept {}
+        void coalesce(void*, std::size_t) noexcept {}
+    };
+
+    char memory[64];
+    auto manager = eightmory::basic_segment_manager_t<eightmory::first_fit_t, eightmory::lazy_coalesce_t, tagged_segment_t, eightmory::no_stats_t, tag_hooks_t>(memory, sizeof(memory));
+
+    auto some_memory = manager.add_segment(8, manager.begin(), audio);
+    ASSERT("manager.add_segment", some_memory != nullptr);
+    manager.remove_segment(some_memory);
+
+    EXPECT("hooks.tag", manager.hooks().allocated == audio && manager.hooks().freed == audio);
+}
+
+TEST(TestTags, TestInvalidTag)
+{
+    char memory[64];
+    auto manager = eightmory::basic_segment_manager_t<eightmory::first_fit_t, eightmory::lazy_coalesce_t, tagged_segment_t>(memory, sizeof(memory));
+
+    // tag is not masked into other tag
+    EXPECT("manager.add_segment.invalid_tag", manager.add_segment(8, manager.begin(), tagged_segment_t::max_tag + 1) == nullptr);
+
+    auto some_memory = manager.add_segment(8, manager.begin(), tagged_segment_t::max_tag);
+    ASSERT("manager.add_segment.max_tag", some_memory != nullptr);
+    EXPECT("segment.tag", eightmory::segment_tag(tagged_segment_t::segment(some_memory)) == tagged_segment_t::max_tag);
+}
@@ -0,0 +1,77 @@
+#include <EightmoryTestingBase.hpp>
+
+#include <Eightmory/Trace.hpp>
+
+#include <cstdio> // remove
+#include <vector> // vector
+
+using eightmory::segment_manager_t;
+
+using eightmory::trace_op_t;
+using eightmory::trace_record_t;
+using eightmory::trace_writer_t;
+using eightmory::trace_reader_t;
+using eightmory::recorded_segment_manager_t;
+
+static const char* trace_path = "EightmoryTestTrace.bin";
+
+TEST(TestTrace, TestRecordAndRead)
+{
+    char memory[64];
+    auto manager = segment_manager_t(memory, sizeof(memory));
+
+    trace_writer_t writer;
+    ASSERT("writer.open", writer.open(trace_path, sizeof(eightmory::segment_t), sizeof(memory)) == true);
+
+    auto recorded = recorded_segment_manager_t<segment_manager_t>(manager, writer);
+    auto eight_size_memory = recorded.add_segment(8);
+    auto four_size_memory = recorded.add_segment(4);
+    ASSERT("recorded.add_segment", eight_size_memory != nullptr && four_size_memory != nullptr);
+
+    EXPECT("recorded.add_segment.failed", recorded.add_segment(1024) == nullptr);
+    EXPECT("recorded.remove_segment", recorded.remove_segment(four_size_memory) == true);
+    EXPECT("recorded.extend_segment", recorded.extend_segment(eight_size_memory, 12) == true);
+    EXPECT("recorded.extend_segment.all", recorded.extend_segment(eight_size_memory) == true);
+    ASSERT("writer.close", writer.close() == true);
+
+    trace_reader_t reader;
+    ASSERT("reader.open", reader.open(trace_path) == true);
+    EXPECT("reader.header", reader.header().segment_bytes == 8 && reader.header().bytes == 64);
+
+    std::vector<trace_record_t> records;
+    trace_record_t record;
+    while (reader.read(record))
+    {
+        records.push_back(record);
+    }
+    reader.close();
+    std::remove(trace_path);
+
+    ASSERT("reader.read.count", records.size() == 6);
+    EXPECT("reader.read.add", records[0].op == trace_op_t::add_segment && records[0].is_success && records[0].size == 8 && records[0].offset == 8);
+    EXPECT("reader.read.add.other", records[1].op == trace_op_t::add_segment && records[1].is_success && records[1].size == 4 && records[1].offset == 24);
+    EXPECT("reader.read.add.failed", records[2].op == trace_op_t::add_segment && !records[2].is_success && records[2].offset == std::size_t(-1));
+    EXPECT("reader.read.remove", records[3].op == trace_op_t::remove_segment && records[3].is_success && records[3].offset == 24);
+    EXPECT("reader.read.extend", records[4].op == trace_op_t::extend_segment_size && records[4].is_success && records[4].size == 12 && records[4].offset == 8);
+    EXPECT("reader.read.extend.all", records[5].op == trace_op_t::extend_segment && records[5].is_success && records[5].offset == 8);
+}
+
+TEST(TestTrace, TestInvalidTrace)
+{
+    auto file = std::fopen(trace_path, "wb");
+    ASSERT("fopen", file != nullptr);
+    std::fputs("not a trace", file);
+    std::fclose(file);
+
+    trace_reader_t reader;
+    EXPECT("reader.open.invalid", reader.open(trace_path) == false);
+    std::remove(trace_path);
+
+    EXPECT("reader.open.missing", reader.open(trace_path) == false);
+
+    trace_record_t record;
+    EXPECT("reader.read.closed", reader.read(record) == false);
+
+    trace_writer_t writer;
+    EXPECT("writer.write.closed", writer.write(record) == false);
+}
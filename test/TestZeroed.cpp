@@ -0,0 +1,81 @@
+#include <EightmoryTestingBase.hpp>
+
+#include <Eightmory/Zeroed.hpp>
+
+#include <vector> // vector
+
+using eightmory::zeroed_segment_manager_t;
+using eightmory::clear_memory;
+
+TEST_SPACE()
+{
+
+bool is_zero(void* memory, std::size_t size) noexcept
+{
+    auto bytes = static_cast<unsigned char*>(memory);
+    for (std::size_t index = 0; index < size; ++index)
+    {
+        if (bytes[index] != 0) return false;
+    }
+    return true;
+}
+
+} // TEST_SPACE
+
+TEST(TestZeroed, TestCleanOffset)
+{
+    char memory[128] = {};
+    auto manager = zeroed_segment_manager_t(memory, sizeof(memory), true);
+    EXPECT("manager.clean_offset", manager.clean_offset() == 8);
+
+    // [8 + 16] (8 + 96), fresh memory is not cleared
+    auto some_memory = manager.add_zeroed_segment(16);
+    ASSERT("manager.add_zeroed_segment", some_memory != nullptr);
+    EXPECT("manager.add_zeroed_segment.fresh", is_zero(some_memory, 16) && manager.cleared_bytes() == 0 && manager.skipped_bytes() == 16);
+    EXPECT("manager.clean_offset.add", manager.clean_offset() == 32);
+
+    for (std::size_t index = 0; index < 16; ++index) static_cast<char*>(some_memory)[index] = 1;
+    manager.remove_segment(some_memory);
+
+    // [8 + 32] (8 + 80), dirty part only is cleared
+    auto other_memory = manager.add_zeroed_segment(32);
+    ASSERT("manager.add_zeroed_segment.reused", other_memory == some_memory);
+    EXPECT("manager.add_zeroed_segment.dirty", is_zero(other_memory, 32) && manager.cleared_bytes() == 24 && manager.skipped_bytes() == 24);
+    EXPECT("manager.clean_offset.reused", manager.clean_offset() == 48);
+
+    // plain allocation moves offset too
+    auto plain_memory = manager.add_segment(8);
+    ASSERT("manager.add_segment", plain_memory != nullptr);
+    EXPECT("manager.clean_offset.plain", manager.clean_offset() == 64);
+
+    EXPECT("manager.extend_segment", manager.extend_segment(plain_memory, 16) == true);
+    EXPECT("manager.clean_offset.extend", manager.clean_offset() == 80);
+}
+
+TEST(TestZeroed, TestDirtyMemory)
+{
+    char memory[64];
+    for (auto& byte : memory) byte = 7;
+
+    auto manager = zeroed_segment_manager_t(memory, sizeof(memory), false);
+    EXPECT("manager.clean_offset", manager.clean_offset() == sizeof(memory));
+
+    auto some_memory = manager.add_zeroed_segment(24);
+    ASSERT("manager.add_zeroed_segment", some_memory != nullptr);
+    EXPECT("manager.add_zeroed_segment.dirty", is_zero(some_memory, 24) && manager.cleared_bytes() == 24 && manager.skipped_bytes() == 0);
+}
+
+TEST(TestZeroed, TestClearMemory)
+{
+    // big block is cleared by non-temporal stores, with unaligned head and tail
+    std::vector<unsigned char> buffer(eightmory::non_temporal_clear_bytes + 200, 0xFF);
+    clear_memory(buffer.data() + 3, buffer.size() - 10);
+
+    EXPECT("clear_memory.big", is_zero(buffer.data() + 3, buffer.size() - 10));
+    EXPECT("clear_memory.big.bounds", buffer[2] == 0xFF && buffer[buffer.size() - 7] == 0xFF);
+
+    unsigned char small[32];
+    for (auto& byte : small) byte = 0xFF;
+    clear_memory(small + 1, 30);
+    EXPECT("clear_memory.small", is_zero(small + 1, 30) && small[0] == 0xFF && small[31] == 0xFF);
+}
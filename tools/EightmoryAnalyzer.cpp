@@ -0,0 +1,267 @@
+// offline analyzer of segment dumps, see Eightmory/Dump.hpp
+// usage: EightmoryAnalyzer <dump> [map_width]
+
+#include <Eightmory/Dump.hpp>
+
+#include <cerrno> // errno
+#include <cstdio> // printf
+#include <cstdlib> // strtoul
+#include <bit> // bit_width
+#include <map> // map
+#include <vector> // vector
+
+using eightmory::segment_info_t;
+using eightmory::segment_dump_reader_t;
+
+static constexpr auto bin_count = sizeof(std::size_t) * 8 + 1;
+
+struct summary_t
+{
+    std::size_t used_bytes = 0;
+    std::size_t used_segments = 0;
+    std::size_t free_bytes = 0;
+    std::size_t free_segments = 0;
+
+    std::size_t largest_free = 0;
+
+    // adjacent free segments, which are merged lazily by manager
+    std::size_t free_runs = 0;
+    std::size_t largest_free_run = 0;
+
+    // free segments that cannot hold any data
+    std::size_t stranded_free_bytes = 0;
+    std::size_t stranded_free_segments = 0;
+
+    std::size_t used_histogram[bin_count] = {};
+    std::size_t free_histogram[bin_count] = {};
+
+    std::map<std::uint32_t, std::size_t> tag_bytes;
+};
+
+static bool read_segments(segment_dump_reader_t& reader, std::vector<segment_info_t>& segments)
+{
+    segment_info_t info;
+    while (reader.read(info))
+    {
+        segments.push_back(info);
+    }
+    return segments.size() == reader.header().count;
+}
+
+// return 'offset of first inconsistent segment' or 'bytes' if layout is valid
+static std::size_t validate_layout(std::vector<segment_info_t> const& segments, std::size_t segment_bytes, std::size_t bytes)
+{
+    auto expected = std::size_t(0);
+    for (auto const& segment : segments)
+    {
+        if (segment.offset != expected)
+        {
+            return expected;
+        }
+        expected = segment.offset + segment_bytes + segment.size;
+    }
+    return expected == bytes ? bytes : expected;
+}
+
+static summary_t summarize(std::vector<segment_info_t> const& segments, std::size_t segment_bytes)
+{
+    summary_t summary;
+
+    auto run = std::size_t(0);
+    auto is_run = false;
+    for (auto const& segment : segments)
+    {
+        auto const bin = static_cast<std::size_t>(std::bit_width(segment.size));
+        if (segment.is_used)
+        {
+            summary.used_bytes += segment.size;
+            summary.used_segments += 1;
+            summary.used_histogram[bin] += 1;
+            summary.tag_bytes[segment.tag] += segment.size;
+
+            is_run = false;
+            continue;
+        }
+
+        summary.free_bytes += segment.size;
+        summary.free_segments += 1;
+        summary.free_histogram[bin] += 1;
+
+        if (segment.size > summary.largest_free)
+        {
+            summary.largest_free = segment.size;
+        }
+
+        if (segment.size < segment_bytes)
+        {
+            summary.stranded_free_bytes += segment.size;
+            summary.stranded_free_segments += 1;
+        }
+
+        // merged run also reuses headers of merged segments
+        run = is_run ? run + segment_bytes + segment.size : segment.size;
+        summary.free_runs += !is_run;
+        is_run = true;
+
+        if (run > summary.largest_free_run)
+        {
+            summary.largest_free_run = run;
+        }
+    }
+    return summary;
+}
+
+static void print_histogram(char const* name, std::size_t const (&histogram)[bin_count])
+{
+    std::printf("%s size histogram:\n", name);
+    for (std::size_t bin = 0; bin < bin_count; ++bin)
+    {
+        if (histogram[bin] == 0)
+        {
+            continue;
+        }
+
+        auto const min_size = bin == 0 ? std::size_t(0) : std::size_t(1) << (bin - 1);
+        auto const max_size = bin == 0 ? std::size_t(0) : std::size_t(-1) >> (bin_count - 1 - bin);
+        std::printf("  [%12zu, %12zu] %zu\n", min_size, max_size, histogram[bin]);
+    }
+}
+
+// each cell is '#' if fully used, '.' if free, '+' if partially used
+static void print_map(std::vector<segment_info_t> const& segments, std::size_t segment_bytes, std::size_t bytes, std::size_t width)
+{
+    auto const line_count = std::size_t(16);
+    auto const cell_count = width * line_count;
+    auto const cell_bytes = (bytes + cell_count - 1) / cell_count;
+
+    std::vector<std::size_t> used(cell_count, 0);
+    for (auto const& segment : segments)
+    {
+        if (!segment.is_used)
+        {
+            continue;
+        }
+
+        auto const first = segment.offset;
+        auto const last = segment.offset + segment_bytes + segment.size;
+        for (auto cell = first / cell_bytes; cell < cell_count && cell * cell_bytes < last; ++cell)
+        {
+            auto const cell_begin = cell * cell_bytes > first ? cell * cell_bytes : first;
+            auto const cell_end = (cell + 1) * cell_bytes < last ? (cell + 1) * cell_bytes : last;
+            used[cell] += cell_end - cell_begin;
+        }
+    }
+
+    std::printf("fragmentation map, %zu bytes per cell:\n", cell_bytes);
+    for (std::size_t line = 0; line < line_count; ++line)
+    {
+        std::printf("  ");
+        for (std::size_t column = 0; column < width; ++column)
+        {
+            auto const cell = line * width + column;
+            if (cell * cell_bytes >= bytes)
+            {
+                break;
+            }
+
+            auto const cell_size = (cell + 1) * cell_bytes <= bytes ? cell_bytes : bytes - cell * cell_bytes;
+            std::putchar(used[cell] == 0 ? '.' : used[cell] >= cell_size ? '#' : '+');
+        }
+        std::putchar('\n');
+    }
+}
+
+// map has 16 lines, so width bounds its cells
+static constexpr auto max_map_width = std::size_t(1024);
+
+// return 'true' if text is whole decimal number, strtoul alone accepts sign and trailing text
+static bool parse_size(char const* text, std::size_t& value) noexcept
+{
+    if (*text < '0' || *text > '9')
+    {
+        return false;
+    }
+
+    char* end = nullptr;
+    errno = 0;
+    auto const parsed = std::strtoul(text, &end, 10);
+    if (errno != 0 || *end != '\0')
+    {
+        return false;
+    }
+
+    value = static_cast<std::size_t>(parsed);
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        std::printf("usage: %s <dump> [map_width]\n", argv[0]);
+        return 1;
+    }
+
+    auto map_width = std::size_t(64);
+    if (argc > 2 && (!parse_size(argv[2], map_width) || map_width > max_map_width))
+    {
+        std::printf("error: '%s' is not a valid map width, expected 0 to %zu\n", argv[2], max_map_width);
+        return 1;
+    }
+
+    segment_dump_reader_t reader;
+    if (!reader.open(argv[1]))
+    {
+        std::printf("error: '%s' is not a segment dump\n", argv[1]);
+        return 1;
+    }
+
+    auto const& header = reader.header();
+    auto const segment_bytes = static_cast<std::size_t>(header.segment_bytes);
+    auto const bytes = static_cast<std::size_t>(header.bytes);
+
+    std::vector<segment_info_t> segments;
+    if (!read_segments(reader, segments))
+    {
+        std::printf("warning: dump is truncated, %zu of %llu segments read\n", segments.size(), static_cast<unsigned long long>(header.count));
+    }
+
+    auto const invalid_offset = validate_layout(segments, segment_bytes, bytes);
+    if (invalid_offset != bytes)
+    {
+        std::printf("warning: layout is broken at offset %zu\n", invalid_offset);
+    }
+
+    auto const summary = summarize(segments, segment_bytes);
+    auto const header_bytes = segments.size() * segment_bytes;
+
+    std::printf("heap: %zu bytes, %zu segments, %zu bytes per header\n", bytes, segments.size(), segment_bytes);
+    std::printf("used: %zu bytes in %zu segments\n", summary.used_bytes, summary.used_segments);
+    std::printf("free: %zu bytes in %zu segments, %zu runs\n", summary.free_bytes, summary.free_segments, summary.free_runs);
+    std::printf("largest free: %zu bytes segment, %zu bytes run\n", summary.largest_free, summary.largest_free_run);
+    std::printf
+    (
+        "fragmentation: %.4f by segments, %.4f by runs\n",
+        summary.free_bytes == 0 ? 0.0 : 1.0 - double(summary.largest_free) / double(summary.free_bytes),
+        summary.free_bytes == 0 ? 0.0 : 1.0 - double(summary.largest_free_run) / double(summary.free_bytes)
+    );
+    std::printf("wasted: %zu header bytes, %zu bytes in %zu stranded free segments\n", header_bytes, summary.stranded_free_bytes, summary.stranded_free_segments);
+
+    if (summary.tag_bytes.size() > 1 || (summary.tag_bytes.size() == 1 && summary.tag_bytes.begin()->first != 0))
+    {
+        std::printf("used bytes by tag:\n");
+        for (auto const& [tag, tag_bytes] : summary.tag_bytes)
+        {
+            std::printf("  %10u %zu\n", tag, tag_bytes);
+        }
+    }
+
+    print_histogram("used", summary.used_histogram);
+    print_histogram("free", summary.free_histogram);
+
+    if (map_width > 0 && bytes > 0)
+    {
+        print_map(segments, segment_bytes, bytes, map_width);
+    }
+    return 0;
+}
@@ -0,0 +1,281 @@
+// deterministic replay of allocation traces, see Eightmory/Trace.hpp
+// usage: EightmoryReplay <trace> [iterations] [bytes]
+
+#include <Eightmory/Core.hpp>
+#include <Eightmory/Dump.hpp>
+#include <Eightmory/Trace.hpp>
+
+#include <cstdio> // printf
+#include <cstdlib> // atoi, strtoull, malloc, realloc, free
+#include <algorithm> // fill
+#include <chrono> // steady_clock
+#include <cstddef> // max_align_t
+#include <unordered_map> // unordered_map
+#include <vector> // vector
+
+using eightmory::trace_op_t;
+using eightmory::trace_record_t;
+using eightmory::trace_reader_t;
+
+static constexpr auto npos = std::size_t(-1);
+
+// trace record with heap offset resolved to allocation id
+struct replay_op_t
+{
+    trace_op_t op = trace_op_t::add_segment;
+    std::size_t id = 0;
+    std::size_t size = 0;
+    bool is_success = false;
+};
+
+struct replay_result_t
+{
+    double seconds = 0.0;
+    // calls that failed in replay, but succeeded in recorded heap
+    std::size_t failures = 0;
+
+    std::size_t peak_extent = 0;
+    std::size_t peak_used_bytes = 0;
+
+    std::size_t free_bytes = 0;
+    std::size_t largest_free_run = 0;
+};
+
+// failed calls are replayed too, since search of lazy coalescing merges free segments anyway
+// return 'count of allocation ids'
+static std::size_t resolve_trace(trace_reader_t& reader, std::vector<replay_op_t>& ops)
+{
+    std::unordered_map<std::size_t, std::size_t> live;
+    auto id_count = std::size_t(0);
+
+    trace_record_t record;
+    while (reader.read(record))
+    {
+        replay_op_t op;
+        op.op = record.op;
+        op.size = record.size;
+        op.is_success = record.is_success;
+
+        if (record.op == trace_op_t::add_segment)
+        {
+            op.id = id_count++;
+            if (record.is_success) live[record.offset] = op.id;
+        }
+        else
+        {
+            auto const it = live.find(record.offset);
+            if (it == live.end())
+            {
+                continue;
+            }
+
+            op.id = it->second;
+            if (record.op == trace_op_t::remove_segment && record.is_success)
+            {
+                live.erase(it);
+            }
+        }
+        ops.push_back(op);
+    }
+    return id_count;
+}
+
+template <typename ManagerType>
+struct manager_target_t
+{
+    using segment_type = typename ManagerType::segment_type;
+
+    manager_target_t(void* memory, std::size_t bytes) noexcept : manager(memory, bytes) {}
+
+    void* add(std::size_t size) noexcept { return manager.add_segment(size); }
+    void* extend(void* memory) noexcept { return manager.extend_segment(memory) ? memory : nullptr; }
+    void* extend(void* memory, std::size_t, std::size_t size) noexcept { return manager.extend_segment(memory, size) ? memory : nullptr; }
+    bool remove(void* memory) noexcept { return manager.remove_segment(memory); }
+
+    std::size_t size(void* memory, std::size_t) const noexcept { return segment_type::segment(memory)->size; }
+
+    std::size_t extent(void* memory) const noexcept
+    {
+        return static_cast<std::size_t>(reinterpret_cast<char*>(memory) + size(memory, 0) - reinterpret_cast<char*>(manager.begin()));
+    }
+
+    void measure(replay_result_t& result) const noexcept
+    {
+        auto run = std::size_t(0);
+        eightmory::walk_segments(manager, [&](eightmory::segment_info_t const& info)
+        {
+            if (info.is_used)
+            {
+                run = 0;
+                return;
+            }
+
+            // adjacent free segments are merged by manager on demand
+            run = run == 0 ? info.size : run + sizeof(segment_type) + info.size;
+            result.free_bytes += info.size;
+            if (run > result.largest_free_run) result.largest_free_run = run;
+        });
+    }
+
+    ManagerType manager;
+};
+
+struct malloc_target_t
+{
+    malloc_target_t(void*, std::size_t) noexcept {}
+
+    void* add(std::size_t size) noexcept { return std::malloc(size == 0 ? 1 : size); }
+
+    // malloc cannot grow in place without size, so extend to neighbour is no-op
+    void* extend(void* memory) noexcept { return memory; }
+
+    // size is extra size, like in extend_segment
+    void* extend(void* memory, std::size_t requested, std::size_t size) noexcept { return std::realloc(memory, requested + size); }
+    bool remove(void* memory) noexcept { std::free(memory); return true; }
+
+    // requested size, since usable size of malloc is not portable
+    std::size_t size(void*, std::size_t requested) const noexcept { return requested; }
+
+    // malloc has no single heap range
+    std::size_t extent(void*) const noexcept { return 0; }
+    void measure(replay_result_t&) const noexcept {}
+};
+
+template <typename TargetType, bool IsMeasured>
+// requested sizes are kept per allocation id for all targets, so malloc pays same O(1) cost as managers
+static void replay_once(std::vector<replay_op_t> const& ops, std::vector<void*>& memory, std::vector<std::size_t>& sizes, void* heap, std::size_t bytes, replay_result_t& result)
+{
+    TargetType target(heap, bytes);
+    std::fill(memory.begin(), memory.end(), nullptr);
+
+    auto used_bytes = std::size_t(0);
+    for (auto const& op : ops)
+    {
+        auto& slot = memory[op.id];
+        auto& requested = sizes[op.id];
+        if (op.op != trace_op_t::add_segment && slot == nullptr)
+        {
+            continue; // allocation failed earlier in this replay
+        }
+
+        if constexpr (IsMeasured)
+        {
+            if (op.op != trace_op_t::add_segment) used_bytes -= target.size(slot, requested);
+        }
+
+        void* updated = nullptr;
+        switch (op.op)
+        {
+        case trace_op_t::add_segment: updated = target.add(op.size); break;
+        case trace_op_t::extend_segment: updated = target.extend(slot); break;
+        case trace_op_t::extend_segment_size: updated = target.extend(slot, requested, op.size); break;
+        case trace_op_t::remove_segment: target.remove(slot); slot = nullptr; continue;
+        }
+
+        if (updated == nullptr)
+        {
+            result.failures += IsMeasured && op.is_success;
+            if (op.op != trace_op_t::add_segment)
+            {
+                if constexpr (IsMeasured) used_bytes += target.size(slot, requested);
+            }
+            continue;
+        }
+        slot = updated;
+        requested = op.op == trace_op_t::add_segment ? op.size : op.op == trace_op_t::extend_segment_size ? requested + op.size : requested;
+
+        if constexpr (IsMeasured)
+        {
+            used_bytes += target.size(slot, requested);
+            if (used_bytes > result.peak_used_bytes) result.peak_used_bytes = used_bytes;
+
+            auto const extent = target.extent(slot);
+            if (extent > result.peak_extent) result.peak_extent = extent;
+        }
+    }
+
+    if constexpr (IsMeasured)
+    {
+        target.measure(result);
+    }
+
+    // release leftovers of malloc target, managers own nothing outside of heap
+    for (auto& slot : memory)
+    {
+        if (slot != nullptr) target.remove(slot);
+    }
+}
+
+template <typename TargetType>
+static replay_result_t replay(std::vector<replay_op_t> const& ops, std::size_t id_count, std::size_t bytes, std::size_t iterations)
+{
+    std::vector<std::max_align_t> heap(bytes / sizeof(std::max_align_t) + 1);
+    std::vector<void*> memory(id_count);
+    std::vector<std::size_t> sizes(id_count);
+
+    replay_result_t result;
+    replay_once<TargetType, true>(ops, memory, sizes, heap.data(), bytes, result);
+
+    // best of iterations, since replay is deterministic and noise is only additive
+    for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+    {
+        auto const start = std::chrono::steady_clock::now();
+        replay_once<TargetType, false>(ops, memory, sizes, heap.data(), bytes, result);
+        auto const seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        if (iteration == 0 || seconds < result.seconds) result.seconds = seconds;
+    }
+    return result;
+}
+
+static void print_result(char const* name, replay_result_t const& result, std::size_t op_count, bool has_heap)
+{
+    auto const ops_per_second = result.seconds > 0.0 ? static_cast<double>(op_count) / result.seconds : 0.0;
+    std::printf("%-20s %14.0f %10zu", name, ops_per_second, result.failures);
+    if (!has_heap)
+    {
+        std::printf(" %14zu %14s %14s\n", result.peak_used_bytes, "-", "-");
+        return;
+    }
+
+    auto const fragmentation = result.free_bytes == 0 ? 0.0
+        : 1.0 - static_cast<double>(result.largest_free_run) / static_cast<double>(result.free_bytes);
+    std::printf(" %14zu %14zu %14.4f\n", result.peak_used_bytes, result.peak_extent, fragmentation);
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        std::printf("usage: %s <trace> [iterations] [bytes]\n", argv[0]);
+        return 1;
+    }
+
+    trace_reader_t reader;
+    if (!reader.open(argv[1]))
+    {
+        std::printf("error: '%s' is not an allocation trace\n", argv[1]);
+        return 1;
+    }
+
+    auto const iterations = argc > 2 ? static_cast<std::size_t>(std::atoi(argv[2])) : std::size_t(10);
+    auto const bytes = argc > 3 ? static_cast<std::size_t>(std::strtoull(argv[3], nullptr, 10)) : static_cast<std::size_t>(reader.header().bytes);
+
+    std::vector<replay_op_t> ops;
+    auto const id_count = resolve_trace(reader, ops);
+
+    std::printf("trace: %zu operations, %zu allocations, recorded on %llu bytes heap with %u bytes headers\n",
+        ops.size(), id_count, static_cast<unsigned long long>(reader.header().bytes), reader.header().segment_bytes);
+    std::printf("replay: %zu bytes heap, best of %zu iterations\n\n", bytes, iterations);
+
+    std::printf("%-20s %14s %10s %14s %14s %14s\n", "policy", "ops/s", "failures", "peak used", "peak extent", "fragmentation");
+
+    using namespace eightmory;
+    print_result("first_fit/lazy", replay<manager_target_t<basic_segment_manager_t<first_fit_t, lazy_coalesce_t, segment_t>>>(ops, id_count, bytes, iterations), ops.size(), true);
+    print_result("first_fit/eager", replay<manager_target_t<basic_segment_manager_t<first_fit_t, eager_coalesce_t, segment_t>>>(ops, id_count, bytes, iterations), ops.size(), true);
+    print_result("best_fit/lazy", replay<manager_target_t<basic_segment_manager_t<best_fit_t, lazy_coalesce_t, segment_t>>>(ops, id_count, bytes, iterations), ops.size(), true);
+    print_result("best_fit/eager", replay<manager_target_t<basic_segment_manager_t<best_fit_t, eager_coalesce_t, segment_t>>>(ops, id_count, bytes, iterations), ops.size(), true);
+    print_result("compact/first_fit", replay<manager_target_t<basic_segment_manager_t<first_fit_t, lazy_coalesce_t, compact_segment_t>>>(ops, id_count, bytes, iterations), ops.size(), true);
+    print_result("malloc", replay<malloc_target_t>(ops, id_count, bytes, iterations), ops.size(), false);
+    return 0;
+}